@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include "../include/matching_engine.hpp"
+#include "../include/order_flow.hpp"
+#include <memory>
+#include <span>
+
+// processOrder one by one vs processBatchOrders at batch sizes 1..1024 on
+// the same generated flow (limit and market orders, no cancels). The
+// engine is rebuilt with timing paused when the flow runs out.
+
+static constexpr std::size_t kFlowLength{ 1 << 18 };
+
+static const std::vector<Order>& flow() {
+    static const std::vector<Order> orders = [] {
+        OrderFlowConfig config;
+        config.seed = 5;
+        config.limitPercent = 85;
+        config.marketPercent = 15;
+        config.cancelPercent = 0;
+        config.aggressivePercent = 20;
+        OrderFlowGenerator generator(config);
+        std::vector<Order> out;
+        out.reserve(kFlowLength);
+        for (std::size_t i = 0; i < kFlowLength; ++i)
+            out.push_back(generator.next().toOrder());
+        return out;
+    }();
+    return orders;
+}
+
+static std::unique_ptr<MatchingEngine> makeEngine() {
+    return std::make_unique<MatchingEngine>(LogMode::Off, OrderBookConfig{ .orderCapacity = kFlowLength }, 1 << 12);
+}
+
+static void BM_PerOrder(benchmark::State& state) {
+    const auto& orders{ flow() };
+    auto engine{ makeEngine() };
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position == orders.size()) {
+            state.PauseTiming();
+            engine = makeEngine();
+            position = 0;
+            state.ResumeTiming();
+        }
+        engine->processOrder(orders[position++]);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["time_per_order"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                         benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_PerOrder);
+
+static void BM_Batch(benchmark::State& state) {
+    const auto batchSize{ static_cast<std::size_t>(state.range(0)) };
+    const auto& orders{ flow() };
+    auto engine{ makeEngine() };
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position + batchSize > orders.size()) {
+            state.PauseTiming();
+            engine = makeEngine();
+            position = 0;
+            state.ResumeTiming();
+        }
+        engine->processBatchOrders(std::span<const Order>(orders).subspan(position, batchSize));
+        position += batchSize;
+    }
+    const auto processed{ static_cast<double>(state.iterations() * batchSize) };
+    state.SetItemsProcessed(static_cast<int64_t>(processed));
+    state.counters["time_per_order"] = benchmark::Counter(processed,
+                                                         benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Batch)->RangeMultiplier(4)->Range(1, 1024);
+
+BENCHMARK_MAIN();
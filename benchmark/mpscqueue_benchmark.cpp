@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "../include/mpscqueue.hpp"
+#include "../include/order.hpp"
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Spin briefly, then yield so the benchmark still makes progress when
+// there are more threads than cores
+static inline void backoff(int& spins) {
+    if (++spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    } else {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+static constexpr uint64_t kMessages{ 1'000'000 };
+
+// N gateway threads push Orders, one consumer drains in batches of 64
+static void BM_MPSCThroughput(benchmark::State& state) {
+    const auto producers{ static_cast<uint64_t>(state.range(0)) };
+    const uint64_t perProducer{ kMessages / producers };
+    auto queue = std::make_unique<MPSCQueue<Order, 4096>>();
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (uint64_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, p, perProducer]() {
+                Order order{0, Side::Buy, OrderType::Limit, 100.0, 1};
+                int spins{ 0 };
+                for (uint64_t i = 0; i < perProducer; ++i) {
+                    order.id = p * perProducer + i;
+                    while (!queue->push(order))
+                        backoff(spins);
+                }
+            });
+        }
+
+        uint64_t checksum{ 0 };
+        int spins{ 0 };
+        for (uint64_t received = 0; received < producers * perProducer;) {
+            std::size_t count{ queue->consume([&](Order& order) { checksum += order.id; }, 64) };
+            if (count == 0)
+                backoff(spins);
+            received += count;
+        }
+        benchmark::DoNotOptimize(checksum);
+        for (auto& thread : threads)
+            thread.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * producers * perProducer));
+}
+BENCHMARK(BM_MPSCThroughput)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
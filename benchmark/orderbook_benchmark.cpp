@@ -1,5 +1,31 @@
 #include <benchmark/benchmark.h>
 #include "../include/order_book.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <new>
+#include <random>
+
+// Count every heap allocation made by the process so the benchmarks can
+// report allocations per order. GCC cannot see that the replaced operator
+// new is malloc-based and flags the matching free() as a mismatch.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+static std::atomic<uint64_t> g_allocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
 
 static void BM_Process10000Orders(benchmark::State& state) {
     for (auto _ : state) {
@@ -12,4 +38,192 @@ static void BM_Process10000Orders(benchmark::State& state) {
     }
 }
 BENCHMARK(BM_Process10000Orders);
+
+// Storage layout used before the order pool: one deque of shared_ptr per level
+class LegacyLevels
+{
+public:
+    explicit LegacyLevels(size_t levels) : _levels(levels) {}
+
+    void add(const Order& order, size_t index) { _levels[index].emplace_back(std::make_shared<Order>(order)); }
+    void fill(size_t index) { _levels[index].pop_front(); }
+
+private:
+    std::vector<std::deque<std::shared_ptr<Order>>> _levels;
+};
+
+// Rest 1000 orders across 10 levels and fill them all again, steady state
+static void BM_AllocationsPerOrder_Legacy(benchmark::State& state) {
+    LegacyLevels levels(2001);
+    uint64_t allocations{ 0 };
+    uint64_t orders{ 0 };
+    for (auto _ : state) {
+        uint64_t before{ g_allocations.load(std::memory_order_relaxed) };
+        for (size_t i = 0; i < 1000; ++i)
+            levels.add({i, Side::Sell, OrderType::Limit, 100.0, 10}, 1000 + i % 10);
+        for (size_t i = 0; i < 1000; ++i)
+            levels.fill(1000 + i % 10);
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+        orders += 1000;
+    }
+    state.counters["allocs_per_order"] = static_cast<double>(allocations) / static_cast<double>(orders);
+}
+BENCHMARK(BM_AllocationsPerOrder_Legacy);
+
+static void BM_AllocationsPerOrder_Pooled(benchmark::State& state) {
+    OrderBook ob(90.0, 110.0, 0.01);
+    uint64_t allocations{ 0 };
+    uint64_t orders{ 0 };
+    uint64_t id{ 0 };
+    for (auto _ : state) {
+        uint64_t before{ g_allocations.load(std::memory_order_relaxed) };
+        for (size_t i = 0; i < 1000; ++i)
+            ob.addOrder({id++, Side::Sell, OrderType::Limit, 100.0 + (i % 10) * 0.01, 10});
+        for (size_t i = 0; i < 100; ++i)
+            ob.processOrder({id++, Side::Buy, OrderType::Market, 0.0, 100});
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+        orders += 1100;
+    }
+    state.counters["allocs_per_order"] = static_cast<double>(allocations) / static_cast<double>(orders);
+}
+BENCHMARK(BM_AllocationsPerOrder_Pooled);
+
+// Market-making flow: every quote is cancelled and re-entered, one aggressive
+// order per ten cancels. Cancels go through the id index, no level scans.
+static Order makeQuote(uint64_t id, size_t i) {
+    Side side{ i % 2 == 0 ? Side::Buy : Side::Sell };
+    double price{ side == Side::Buy ? 99.99 - (i % 20) * 0.01 : 100.01 + (i % 20) * 0.01 };
+    return {id, side, OrderType::Limit, price, 10};
+}
+
+static void BM_CancelHeavy(benchmark::State& state) {
+    const size_t resting{ static_cast<size_t>(state.range(0)) };
+    OrderBook ob(OrderBookConfig{ 90.0, 110.0, 0.01, resting * 2 });
+    std::mt19937_64 rng{ 42 };
+    std::vector<uint64_t> live;
+    live.reserve(resting);
+
+    uint64_t id{ 0 };
+    for (size_t i = 0; i < resting; ++i) {
+        ob.addOrder(makeQuote(id, i));
+        live.push_back(id++);
+    }
+
+    uint64_t cancels{ 0 };
+    for (auto _ : state) {
+        for (int k = 0; k < 10; ++k) {
+            size_t slot{ rng() % live.size() };
+            const Order* order{ ob.findOrder(live[slot]) };
+            // Quotes taken out by the aggressive flow are simply re-entered
+            Order quote{ order != nullptr ? *order : makeQuote(0, slot) };
+            if (order != nullptr) {
+                benchmark::DoNotOptimize(ob.cancelOrder(live[slot]));
+                ++cancels;
+            }
+
+            quote.id = id++;
+            ob.addOrder(quote);
+            live[slot] = quote.id;
+        }
+        Side side{ rng() % 2 == 0 ? Side::Buy : Side::Sell };
+        ob.processOrder({id++, side, OrderType::Market, 0.0, 5});
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(cancels));
+}
+BENCHMARK(BM_CancelHeavy)->Arg(1000)->Arg(100000);
+
+// Same mixed flow through the classic book (std::function hook set, run-time
+// tick) and a book whose sink and tick are compile-time policies
+template <typename Book>
+static void BM_PolicyBook(benchmark::State& state) {
+    std::mt19937_64 rng{ 42 };
+    std::vector<Order> orders;
+    for (uint64_t id = 0; id < 1 << 16; ++id) {
+        Side side{ rng() % 2 == 0 ? Side::Buy : Side::Sell };
+        OrderType type{ rng() % 10 == 0 ? OrderType::Market : OrderType::Limit };
+        int64_t ticks{ 10'000 + (side == Side::Buy ? -1 : 1) * (static_cast<int64_t>(rng() % 40) - 5) };
+        orders.push_back({ id, side, type, Price::fromRaw(ticks * 10'000), 1 + rng() % 20 });
+    }
+
+    uint64_t trades{ 0 };
+    for (auto _ : state) {
+        state.PauseTiming();
+        Book book(OrderBookConfig{ .minPrice = 90.0, .maxPrice = 110.0, .orderCapacity = orders.size(),
+                                   .tradeRetention = 1 << 10 });
+        if constexpr (requires { book.setOnTradeCallback([](const Trade&) {}); })
+            book.setOnTradeCallback([&trades](const Trade&) { ++trades; });
+        state.ResumeTiming();
+        for (const Order& order : orders)
+            book.processOrder(order);
+        benchmark::DoNotOptimize(book.getTrades().nextSequence());
+    }
+    benchmark::DoNotOptimize(trades);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * orders.size()));
+}
+BENCHMARK(BM_PolicyBook<OrderBook>)->Name("BM_PolicyBook/classic");
+BENCHMARK(BM_PolicyBook<BasicOrderBook<NullSink, FixedTick<10'000>>>)->Name("BM_PolicyBook/null_sink_fixed_tick");
+
+// Call auction over `levels` crossed ticks, one order per side per tick.
+// Equilibrium: the cumulative-depth passes alone; Uncross: passes plus
+// executing half the book, with the book rebuilt outside the timing.
+static void fillCrossedBook(OrderBook& book, int64_t levels) {
+    book.startAuction();
+    uint64_t id{ 0 };
+    for (int64_t i = 0; i < levels; ++i) {
+        book.processOrder({id++, Side::Buy, OrderType::Limit, Price::fromRaw((9'000 + i) * 10'000), 10});
+        book.processOrder({id++, Side::Sell, OrderType::Limit, Price::fromRaw((9'000 + i) * 10'000), 10});
+    }
+}
+
+static void BM_AuctionEquilibrium(benchmark::State& state) {
+    OrderBook book(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 1000.0, .orderCapacity = 1 << 16 });
+    fillCrossedBook(book, state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(book.indicativeUncross());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AuctionEquilibrium)->Arg(1000)->Arg(10000);
+
+static void BM_Uncross(benchmark::State& state) {
+    std::unique_ptr<OrderBook> book;
+    for (auto _ : state) {
+        state.PauseTiming();
+        book.reset(); // the previous book is torn down outside the timing too
+        book = std::make_unique<OrderBook>(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 1000.0, .orderCapacity = 1 << 16 });
+        fillCrossedBook(*book, state.range(0));
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(book->uncross());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Uncross)->Arg(1000)->Arg(10000);
+
+// Fill-or-kill check for 500 lots against `levels` ask levels of 10 orders
+// each: the per-level aggregates vs summing every resting order of the side
+static void fillDeepAsks(OrderBook& book, int64_t levels) {
+    uint64_t id{ 0 };
+    for (int64_t i = 0; i < levels; ++i)
+        for (int k = 0; k < 10; ++k)
+            book.addOrder({id++, Side::Sell, OrderType::Limit, Price::fromRaw((10'000 + i) * 10'000), 1});
+}
+
+static void BM_FillCheck_Aggregates(benchmark::State& state) {
+    OrderBook book(OrderBookConfig{ .minPrice = 90.0, .maxPrice = 200.0, .orderCapacity = 1 << 17 });
+    fillDeepAsks(book, state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(book.canFillAll(Side::Buy, 500, Price{ 1e9 }));
+}
+BENCHMARK(BM_FillCheck_Aggregates)->Arg(100)->Arg(1000);
+
+static void BM_FillCheck_WalkOrders(benchmark::State& state) {
+    OrderBook book(OrderBookConfig{ .minPrice = 90.0, .maxPrice = 200.0, .orderCapacity = 1 << 17 });
+    fillDeepAsks(book, state.range(0));
+    for (auto _ : state) {
+        uint64_t available{ 0 };
+        book.forEachOrder(Side::Sell, [&](const Order& order) { available += order.quantity; });
+        benchmark::DoNotOptimize(available >= 500);
+    }
+}
+BENCHMARK(BM_FillCheck_WalkOrders)->Arg(100)->Arg(1000);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include "../include/matching_engine.hpp"
+#include <filesystem>
+#include <map>
+
+static constexpr uint64_t kJournalTail{ 10'000 };
+
+static OrderBookConfig restartConfig(uint64_t orders) {
+    return OrderBookConfig{ .minPrice = 0.0, .maxPrice = 200.0, .tickSize = 0.01,
+                            .orderCapacity = orders + kJournalTail, .tradeRetention = 1 << 12 };
+}
+
+// Non-crossing resting order: bids in [90, 100), asks in [100, 110)
+static Order restingOrder(uint64_t id) {
+    bool buy{ id % 2 == 0 };
+    int64_t tick{ static_cast<int64_t>((id * 7919) % 1000) };
+    Price price{ Price::fromRaw((buy ? 9'000 + tick : 10'000 + tick) * 10'000) };
+    return Order{ id, buy ? Side::Buy : Side::Sell, OrderType::Limit, price, 1 + id % 50 };
+}
+
+struct RestartFiles {
+    std::string snapshot;
+    std::string tailJournal; // inputs after the snapshot
+    std::string fullJournal; // every input since the start
+};
+
+// Built once per book size, outside the timed region
+static const RestartFiles& restartFiles(uint64_t orders) {
+    static std::map<uint64_t, RestartFiles> cache;
+    auto it = cache.find(orders);
+    if (it != cache.end())
+        return it->second;
+
+    auto dir = std::filesystem::temp_directory_path();
+    RestartFiles files{ (dir / ("restart_snapshot_" + std::to_string(orders))).string(),
+                        (dir / ("restart_tail_" + std::to_string(orders))).string(),
+                        (dir / ("restart_full_" + std::to_string(orders))).string() };
+    std::filesystem::remove(files.snapshot);
+    std::filesystem::remove(files.tailJournal);
+    std::filesystem::remove(files.fullJournal);
+
+    {
+        MatchingEngine full(LogMode::Off, restartConfig(orders), 0);
+        full.openJournal(files.fullJournal);
+        MatchingEngine tail(LogMode::Off, restartConfig(orders), 0);
+        for (uint64_t id = 0; id < orders; ++id) {
+            full.processOrder(restingOrder(id));
+            tail.processOrder(restingOrder(id));
+        }
+        tail.saveSnapshot(files.snapshot);
+        tail.openJournal(files.tailJournal);
+        for (uint64_t id = orders; id < orders + kJournalTail; ++id) {
+            full.processOrder(restingOrder(id));
+            tail.processOrder(restingOrder(id));
+        }
+    }
+    return cache.emplace(orders, files).first->second;
+}
+
+// Restart = fresh engine + latest snapshot + journal tail
+static void BM_RestartFromSnapshot(benchmark::State& state) {
+    const auto orders{ static_cast<uint64_t>(state.range(0)) };
+    const RestartFiles& files{ restartFiles(orders) };
+
+    for (auto _ : state) {
+        MatchingEngine engine(LogMode::Off, restartConfig(orders), 0);
+        benchmark::DoNotOptimize(engine.recover(files.snapshot, files.tailJournal));
+    }
+    state.counters["resting_orders"] = static_cast<double>(orders + kJournalTail);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (orders + kJournalTail)));
+}
+BENCHMARK(BM_RestartFromSnapshot)->Arg(1 << 18)->Arg(1 << 20)->Arg(1 << 21)->Unit(benchmark::kMillisecond);
+
+// Baseline: no snapshot, the whole journal is replayed
+static void BM_RestartFromFullJournal(benchmark::State& state) {
+    const auto orders{ static_cast<uint64_t>(state.range(0)) };
+    const RestartFiles& files{ restartFiles(orders) };
+
+    for (auto _ : state) {
+        MatchingEngine engine(LogMode::Off, restartConfig(orders), 0);
+        benchmark::DoNotOptimize(engine.recover(files.snapshot + ".missing", files.fullJournal));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (orders + kJournalTail)));
+}
+BENCHMARK(BM_RestartFromFullJournal)->Arg(1 << 18)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
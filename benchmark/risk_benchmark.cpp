@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include "../include/matching_engine.hpp"
+#include "../include/order_flow.hpp"
+#include "../include/pre_trade_risk.hpp"
+#include <memory>
+
+// Overhead of the inline pre-trade risk stage: the same generated flow
+// (limits, markets and cancels spread over 64 accounts) straight into the
+// engine, and through PreTradeRisk with every check enabled but limits
+// wide enough that nothing is refused. BM_RiskCheck times check() alone.
+
+static constexpr std::size_t kFlowLength{ 1 << 18 };
+static constexpr std::size_t kAccounts{ 64 };
+
+static const std::vector<JournalRecord>& flow() {
+    static const std::vector<JournalRecord> records = [] {
+        OrderFlowConfig config;
+        config.seed = 9;
+        OrderFlowGenerator generator(config);
+        std::vector<JournalRecord> out;
+        out.reserve(kFlowLength);
+        for (std::size_t i = 0; i < kFlowLength; ++i)
+            out.push_back(generator.next());
+        return out;
+    }();
+    return records;
+}
+
+static Order toAccountOrder(const JournalRecord& record) {
+    Order order{ record.toOrder() };
+    order.account = static_cast<AccountId>(order.id % kAccounts);
+    return order;
+}
+
+static std::unique_ptr<MatchingEngine> makeEngine() {
+    return std::make_unique<MatchingEngine>(LogMode::Off, OrderBookConfig{ .orderCapacity = kFlowLength }, 1 << 12);
+}
+
+static std::unique_ptr<PreTradeRisk> makeRisk() {
+    auto risk{ std::make_unique<PreTradeRisk>(kAccounts, kFlowLength) };
+    for (AccountId account = 0; account < kAccounts; ++account)
+        risk->setLimits(account, { .maxOrderQty = 1'000'000,
+                                   .priceCollar = 1'000.0,
+                                   .maxPosition = 1'000'000'000,
+                                   .maxNotional = 1e12,
+                                   .maxMessagesPerSecond = 1'000'000'000,
+                                   .burst = 1'000'000 });
+    return risk;
+}
+
+static void setCounters(benchmark::State& state) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["time_per_message"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                           benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_MatchingOnly(benchmark::State& state) {
+    const auto& records{ flow() };
+    auto engine{ makeEngine() };
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position == records.size()) {
+            state.PauseTiming();
+            engine = makeEngine();
+            position = 0;
+            state.ResumeTiming();
+        }
+        const JournalRecord& record{ records[position++] };
+        if (record.kind == JournalKind::Cancel)
+            engine->cancelOrder(record.targetId);
+        else
+            engine->processOrder(toAccountOrder(record));
+    }
+    setCounters(state);
+}
+BENCHMARK(BM_MatchingOnly);
+
+static void BM_RiskAndMatching(benchmark::State& state) {
+    const auto& records{ flow() };
+    auto engine{ makeEngine() };
+    auto risk{ makeRisk() };
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position == records.size()) {
+            state.PauseTiming();
+            engine = makeEngine();
+            risk = makeRisk();
+            position = 0;
+            state.ResumeTiming();
+        }
+        const JournalRecord& record{ records[position++] };
+        if (record.kind == JournalKind::Cancel)
+            risk->cancel(*engine, record.targetId);
+        else
+            risk->submit(*engine, toAccountOrder(record));
+    }
+    for (RiskReject reason : { RiskReject::Throttled, RiskReject::OrderSize, RiskReject::PriceCollar,
+                               RiskReject::Position, RiskReject::Notional })
+        if (risk->rejected(reason) != 0)
+            state.SkipWithError("the risk limits refused part of the flow");
+    setCounters(state);
+}
+BENCHMARK(BM_RiskAndMatching);
+
+static void BM_RiskCheck(benchmark::State& state) {
+    const auto& records{ flow() };
+    auto risk{ makeRisk() };
+    std::optional<Price> bid{ Price{ 99.99 } };
+    std::optional<Price> ask{ Price{ 100.01 } };
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position == records.size())
+            position = 0;
+        const JournalRecord& record{ records[position++] };
+        if (record.kind == JournalKind::Cancel)
+            continue;
+        benchmark::DoNotOptimize(risk->check(toAccountOrder(record), bid, ask));
+    }
+    setCounters(state);
+}
+BENCHMARK(BM_RiskCheck);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include "../include/sharded_engine.hpp"
+#include <random>
+
+// Independent instruments spread over 1..N matching threads. Scaling is
+// only meaningful when the machine has at least as many cores as shards
+// plus one for the router.
+static constexpr std::size_t kInstruments{ 64 };
+static constexpr std::size_t kOrders{ 200'000 };
+
+static std::vector<Order> makeFlow() {
+    std::mt19937_64 rng{ 7 };
+    std::vector<Order> orders;
+    orders.reserve(kOrders);
+    for (uint64_t id = 0; id < kOrders; ++id) {
+        Side side{ rng() % 2 == 0 ? Side::Buy : Side::Sell };
+        OrderType type{ rng() % 10 == 0 ? OrderType::Market : OrderType::Limit };
+        double offset{ static_cast<double>(rng() % 50) * 0.01 };
+        double price{ side == Side::Buy ? 100.0 - offset : 100.0 + offset - 0.25 };
+        orders.push_back({id, side, type, price, 1 + rng() % 100, static_cast<InstrumentId>(rng() % kInstruments)});
+    }
+    return orders;
+}
+
+static void BM_ShardedEngineScaling(benchmark::State& state) {
+    static const std::vector<Order> flow{ makeFlow() };
+    const std::size_t shards{ static_cast<std::size_t>(state.range(0)) };
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        ShardedEngine engine(shards);
+        for (std::size_t i = 0; i < kInstruments; ++i)
+            engine.addInstrument("SYM" + std::to_string(i),
+                                 OrderBookConfig{ .minPrice = 90.0, .maxPrice = 110.0, .tickSize = 0.01,
+                                                  .orderCapacity = 1 << 14 });
+        engine.start();
+        state.ResumeTiming();
+
+        for (const auto& order : flow)
+            engine.submit(order);
+        engine.stop();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kOrders));
+}
+BENCHMARK(BM_ShardedEngineScaling)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include "../include/order.hpp"
+#include "../include/spscqueue.hpp"
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Spin briefly, then yield so the benchmarks still make progress when
+// producer and consumer share a core
+static inline void backoff(int& spins) {
+    if (++spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    } else {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+static constexpr uint64_t kMessages{ 1'000'000 };
+
+// Producer thread pushes one Order at a time, consumer pops one at a time
+static void BM_SPSCThroughput(benchmark::State& state) {
+    auto queue = std::make_unique<SPSCQueue<Order, 4096>>();
+    for (auto _ : state) {
+        std::thread producer([&]() {
+            Order order{0, Side::Buy, OrderType::Limit, 100.0, 1};
+            int spins{ 0 };
+            for (uint64_t i = 0; i < kMessages; ++i) {
+                order.id = i;
+                while (!queue->push(order))
+                    backoff(spins);
+            }
+        });
+        Order order;
+        int spins{ 0 };
+        for (uint64_t received = 0; received < kMessages;) {
+            if (queue->pop(order))
+                ++received;
+            else
+                backoff(spins);
+        }
+        benchmark::DoNotOptimize(order.id);
+        producer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kMessages));
+}
+BENCHMARK(BM_SPSCThroughput)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Same flow, consumer processes claimed spans in place
+static void BM_SPSCThroughputClaimBatch(benchmark::State& state) {
+    auto queue = std::make_unique<SPSCQueue<Order, 4096>>();
+    const std::size_t batch{ static_cast<std::size_t>(state.range(0)) };
+    for (auto _ : state) {
+        std::thread producer([&]() {
+            int spins{ 0 };
+            for (uint64_t sent = 0; sent < kMessages;) {
+                std::span<Order> slots{ queue->claimWrite(std::min<uint64_t>(batch, kMessages - sent)) };
+                if (slots.empty()) {
+                    backoff(spins);
+                    continue;
+                }
+                for (auto& slot : slots)
+                    slot = Order{sent++, Side::Buy, OrderType::Limit, 100.0, 1};
+                queue->commitWrite(slots.size());
+            }
+        });
+        uint64_t checksum{ 0 };
+        int spins{ 0 };
+        for (uint64_t received = 0; received < kMessages;) {
+            std::span<Order> items{ queue->claimRead(batch) };
+            if (items.empty()) {
+                backoff(spins);
+                continue;
+            }
+            for (const auto& item : items)
+                checksum += item.id;
+            queue->commitRead(items.size());
+            received += items.size();
+        }
+        benchmark::DoNotOptimize(checksum);
+        producer.join();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kMessages));
+}
+BENCHMARK(BM_SPSCThroughputClaimBatch)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Round trip through two queues; reported time is per round trip
+static void BM_SPSCPingPong(benchmark::State& state) {
+    auto ping = std::make_unique<SPSCQueue<uint64_t, 64>>();
+    auto pong = std::make_unique<SPSCQueue<uint64_t, 64>>();
+    std::atomic<bool> done{ false };
+
+    std::thread echo([&]() {
+        uint64_t value{ 0 };
+        int spins{ 0 };
+        while (!done.load(std::memory_order_relaxed)) {
+            if (ping->pop(value)) {
+                while (!pong->push(value))
+                    backoff(spins);
+            } else {
+                backoff(spins);
+            }
+        }
+    });
+
+    uint64_t value{ 0 };
+    for (auto _ : state) {
+        int spins{ 0 };
+        ping->push(value);
+        while (!pong->pop(value))
+            backoff(spins);
+        ++value;
+    }
+    done = true;
+    echo.join();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_SPSCPingPong)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include "../include/order_flow.hpp"
+#include "../include/wire_protocol.hpp"
+#include <vector>
+
+// Codec cost per message: encoding orders and execution reports into a
+// send buffer, validating and decoding single frames in place, and walking
+// a receive buffer of back-to-back frames with decodeFrames(). The flow is
+// the generator's mix of new orders and cancels.
+
+static constexpr std::size_t kFlowLength{ 1 << 16 };
+
+static const std::vector<JournalRecord>& flow() {
+    static const std::vector<JournalRecord> records = [] {
+        OrderFlowConfig config;
+        config.seed = 25;
+        OrderFlowGenerator generator(config);
+        std::vector<JournalRecord> out(kFlowLength);
+        generator.generate(out.data(), out.size());
+        return out;
+    }();
+    return records;
+}
+
+static std::size_t encodeRecord(std::span<std::byte> out, const JournalRecord& record) {
+    return record.kind == JournalKind::Cancel ? encodeCancel(out, record.targetId)
+                                              : encodeNewOrder(out, record.toOrder());
+}
+
+// The whole flow as one receive buffer
+static const std::vector<std::byte>& stream() {
+    static const std::vector<std::byte> bytes = [] {
+        std::vector<std::byte> out(kFlowLength * WireLayout::kMaxFrameSize);
+        std::size_t size{ 0 };
+        for (const auto& record : flow())
+            size += encodeRecord(std::span{ out }.subspan(size), record);
+        out.resize(size);
+        return out;
+    }();
+    return bytes;
+}
+
+static void setCounters(benchmark::State& state, int64_t messages, int64_t bytes) {
+    state.SetItemsProcessed(messages);
+    state.SetBytesProcessed(bytes);
+    state.counters["time_per_message"] = benchmark::Counter(static_cast<double>(messages),
+                                                           benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static void BM_EncodeOrder(benchmark::State& state) {
+    std::vector<Order> orders;
+    for (const auto& record : flow())
+        if (record.kind == JournalKind::New)
+            orders.push_back(record.toOrder());
+    std::vector<std::byte> buffer(WireLayout::kMaxFrameSize);
+    std::size_t position{ 0 };
+    int64_t bytes{ 0 };
+    for (auto _ : state) {
+        bytes += static_cast<int64_t>(encodeNewOrder(buffer, orders[position]));
+        benchmark::ClobberMemory();
+        if (++position == orders.size())
+            position = 0;
+    }
+    setCounters(state, static_cast<int64_t>(state.iterations()), bytes);
+}
+BENCHMARK(BM_EncodeOrder);
+
+static void BM_EncodeExecutionReport(benchmark::State& state) {
+    std::vector<std::byte> buffer(WireLayout::kExecutionReportSize);
+    ExecutionReport report{ 1, ExecStatus::PartiallyFilled, Price{ 100.0 }, 100 };
+    report.filledQty = 40;
+    report.leavesQty = 60;
+    report.avgFillPrice = Price{ 99.99 };
+    for (auto _ : state) {
+        ++report.id;
+        benchmark::DoNotOptimize(encodeExecutionReport(buffer, report));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, static_cast<int64_t>(state.iterations()),
+                static_cast<int64_t>(state.iterations() * WireLayout::kExecutionReportSize));
+}
+BENCHMARK(BM_EncodeExecutionReport);
+
+// peekFrame() and conversion of one frame to the engine's input record
+static void BM_DecodeFrame(benchmark::State& state) {
+    std::span<const std::byte> bytes{ stream() };
+    std::size_t offset{ 0 };
+    int64_t decoded{ 0 };
+    WireFrame frame;
+    for (auto _ : state) {
+        if (offset == bytes.size())
+            offset = 0;
+        if (peekFrame(bytes.subspan(offset), frame) != WireError::None) {
+            state.SkipWithError("malformed frame in the benchmark stream");
+            break;
+        }
+        benchmark::DoNotOptimize(frame.record());
+        offset += frame.size();
+        decoded += static_cast<int64_t>(frame.size());
+    }
+    setCounters(state, static_cast<int64_t>(state.iterations()), decoded);
+}
+BENCHMARK(BM_DecodeFrame);
+
+// decodeFrames() over the whole receive buffer, per message
+static void BM_DecodeStream(benchmark::State& state) {
+    std::span<const std::byte> bytes{ stream() };
+    int64_t messages{ 0 };
+    for (auto _ : state) {
+        std::size_t consumed{ 0 };
+        WireError error{ decodeFrames(bytes, consumed, [&messages](const WireFrame& frame) {
+            benchmark::DoNotOptimize(frame.record());
+            ++messages;
+        }) };
+        if (error != WireError::None) {
+            state.SkipWithError("malformed frame in the benchmark stream");
+            break;
+        }
+    }
+    setCounters(state, messages, static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+BENCHMARK(BM_DecodeStream);
+
+BENCHMARK_MAIN();
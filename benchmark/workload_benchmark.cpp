@@ -0,0 +1,238 @@
+#include <benchmark/benchmark.h>
+#include "../include/matching_engine.hpp"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <tuple>
+
+// Parameterized workloads for OrderBook and MatchingEngine. Every workload
+// is an input stream (JournalRecord) generated once per argument set by
+// running it against a scratch book, so cancels always target live orders.
+// The timed loop applies one input per iteration to a book that was set up
+// with the warm-up prefix outside the timed region; when the stream runs
+// out the book is rebuilt with timing paused.
+
+static constexpr std::size_t kStreamLength{ 1 << 18 };
+
+struct FlowShape
+{
+    int addPercent;        // passive limit orders
+    int cancelPercent;     // cancels of a random live order
+    int spreadTicks;       // passive orders rest within this distance of the mid
+    int driftEvery;        // move the mid one tick every N inputs (0 = fixed)
+    std::size_t prefill;   // passive orders entered before timing starts
+    // the rest are aggressive: half market orders, half crossing limits
+};
+
+struct Workload
+{
+    OrderBookConfig config;
+    std::vector<JournalRecord> warmup;
+    std::vector<JournalRecord> inputs;
+};
+
+static void apply(OrderBook& book, const JournalRecord& record) {
+    switch (record.kind) {
+        case JournalKind::New:     book.processOrder(record.toOrder()); break;
+        case JournalKind::Cancel:  book.cancelOrder(record.targetId); break;
+        case JournalKind::Reduce:  book.reduceOrder(record.targetId, record.quantity); break;
+        case JournalKind::Replace: book.replaceOrder(record.targetId, record.toOrder()); break;
+        case JournalKind::Auction: book.startAuction(); break;
+        case JournalKind::Uncross: book.uncross(); break;
+    }
+}
+
+static void apply(MatchingEngine& engine, const JournalRecord& record) {
+    engine.apply(record);
+}
+
+static Workload makeWorkload(const FlowShape& shape, const OrderBookConfig& config, uint64_t seed) {
+    Workload workload{ config, {}, {} };
+    OrderBook scratch(config);
+    std::mt19937_64 rng{ seed };
+    std::vector<uint64_t> live;
+    uint64_t id{ 0 };
+    uint64_t sequence{ 0 };
+    int64_t tick{ Price{ config.tickSize }.raw() };
+    int64_t mid{ (Price{ config.minPrice }.raw() + Price{ config.maxPrice }.raw()) / 2 / tick };
+
+    auto passive = [&]() {
+        Side side{ rng() % 2 == 0 ? Side::Buy : Side::Sell };
+        int64_t distance{ 1 + static_cast<int64_t>(rng() % static_cast<uint64_t>(shape.spreadTicks)) };
+        Price price{ Price::fromRaw((side == Side::Buy ? mid - distance : mid + distance) * tick) };
+        Order order{ id++, side, OrderType::Limit, price, 1 + rng() % 20 };
+        live.push_back(order.id);
+        return JournalRecord::fromOrder(++sequence, JournalKind::New, order);
+    };
+
+    auto next = [&](std::size_t i) {
+        if (shape.driftEvery != 0 && i % static_cast<std::size_t>(shape.driftEvery) == 0)
+            ++mid;
+
+        int roll{ static_cast<int>(rng() % 100) };
+        if (roll < shape.addPercent)
+            return passive();
+
+        if (roll < shape.addPercent + shape.cancelPercent) {
+            // Drop ids that were filled since they were entered
+            while (!live.empty()) {
+                std::size_t slot{ rng() % live.size() };
+                uint64_t target{ live[slot] };
+                live[slot] = live.back();
+                live.pop_back();
+                if (scratch.findOrder(target) != nullptr)
+                    return JournalRecord{ ++sequence, JournalKind::Cancel, 0, 0, 0, 0, 0, target, 0, 0 };
+            }
+            return passive();
+        }
+
+        Side side{ rng() % 2 == 0 ? Side::Buy : Side::Sell };
+        bool market{ rng() % 2 == 0 };
+        int64_t through{ static_cast<int64_t>(rng() % static_cast<uint64_t>(shape.spreadTicks)) };
+        Price price{ Price::fromRaw((side == Side::Buy ? mid + through : mid - through) * tick) };
+        Order order{ id++, side, market ? OrderType::Market : OrderType::Limit, market ? Price{ 0.0 } : price,
+                     1 + rng() % 40 };
+        if (!market)
+            live.push_back(order.id);
+        return JournalRecord::fromOrder(++sequence, JournalKind::New, order);
+    };
+
+    for (std::size_t i = 0; i < shape.prefill; ++i) {
+        workload.warmup.push_back(passive());
+        apply(scratch, workload.warmup.back());
+    }
+    workload.inputs.reserve(kStreamLength);
+    for (std::size_t i = 0; i < kStreamLength; ++i) {
+        workload.inputs.push_back(next(i));
+        apply(scratch, workload.inputs.back());
+    }
+    return workload;
+}
+
+template <typename Target, typename Make>
+static void runWorkload(benchmark::State& state, const Workload& workload, Make make) {
+    std::unique_ptr<Target> target;
+    auto reset = [&]() {
+        target.reset();
+        target = make();
+        for (const auto& record : workload.warmup)
+            apply(*target, record);
+    };
+    reset();
+
+    std::size_t position{ 0 };
+    for (auto _ : state) {
+        if (position == workload.inputs.size()) {
+            state.PauseTiming();
+            reset();
+            position = 0;
+            state.ResumeTiming();
+        }
+        apply(*target, workload.inputs[position++]);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.counters["time_per_op"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                                                      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+static const Workload& cachedWorkload(const FlowShape& shape, const OrderBookConfig& config) {
+    using Key = std::tuple<int, int, int, int, std::size_t, double, double, double, std::size_t>;
+    static std::map<Key, Workload> cache;
+    Key key{ shape.addPercent, shape.cancelPercent, shape.spreadTicks, shape.driftEvery, shape.prefill,
+             config.minPrice, config.maxPrice, config.tickSize, config.windowLevels };
+    auto it = cache.find(key);
+    if (it == cache.end())
+        it = cache.emplace(key, makeWorkload(shape, config, 2024)).first;
+    return it->second;
+}
+
+static OrderBookConfig bookConfig(double minPrice, double maxPrice, std::size_t windowLevels = 0) {
+    return OrderBookConfig{ .minPrice = minPrice, .maxPrice = maxPrice, .tickSize = 0.01,
+                            .orderCapacity = kStreamLength, .windowLevels = windowLevels,
+                            .tradeRetention = 1 << 12 };
+}
+
+// Deep passive book: adds and cancels spread over `depth` levels per side
+static void BM_DeepPassiveBook(benchmark::State& state) {
+    const auto depth{ static_cast<int>(state.range(0)) };
+    FlowShape shape{ 50, 50, depth, 0, static_cast<std::size_t>(depth) * 8 };
+    OrderBookConfig config{ bookConfig(0.0, 10000.0) };
+    const Workload& workload{ cachedWorkload(shape, config) };
+    runWorkload<OrderBook>(state, workload, [&]() { return std::make_unique<OrderBook>(config); });
+}
+BENCHMARK(BM_DeepPassiveBook)->Arg(10)->Arg(1000)->Arg(100000);
+
+// Cancel-heavy mix: of the inputs that remove liquidity, this percent are cancels
+static void BM_CancelHeavyMix(benchmark::State& state) {
+    const auto cancelShare{ static_cast<int>(state.range(0)) };
+    FlowShape shape{ 50, cancelShare / 2, 50, 0, 10000 };
+    OrderBookConfig config{ bookConfig(0.0, 10000.0) };
+    const Workload& workload{ cachedWorkload(shape, config) };
+    runWorkload<OrderBook>(state, workload, [&]() { return std::make_unique<OrderBook>(config); });
+}
+BENCHMARK(BM_CancelHeavyMix)->Arg(50)->Arg(90)->Arg(98);
+
+// Same flow on a narrow grid (2k levels), the whole default grid (1M levels)
+// and the whole grid with a 4096-level sliding window
+static void BM_PriceRangeWidth(benchmark::State& state) {
+    FlowShape shape{ 45, 40, 200, 0, 10000 };
+    OrderBookConfig config{ state.range(0) == 0 ? bookConfig(4990.0, 5010.0)
+                          : bookConfig(0.0, 10000.0, state.range(0) == 2 ? 4096 : 0) };
+    const Workload& workload{ cachedWorkload(shape, config) };
+    runWorkload<OrderBook>(state, workload, [&]() { return std::make_unique<OrderBook>(config); });
+    state.SetLabel(state.range(0) == 0 ? "narrow" : state.range(0) == 1 ? "wide" : "wide_window");
+}
+BENCHMARK(BM_PriceRangeWidth)->Arg(0)->Arg(1)->Arg(2);
+
+// Drifting mid: resting orders are left behind, sweeps and best-price
+// scans cross empty levels. Args: ticks moved per 1000 inputs, window levels
+static void BM_PriceDrift(benchmark::State& state) {
+    const auto ticksPerThousand{ static_cast<int>(state.range(0)) };
+    FlowShape shape{ 45, 35, 20, ticksPerThousand == 0 ? 0 : 1000 / ticksPerThousand, 2000 };
+    OrderBookConfig config{ bookConfig(0.0, 10000.0, static_cast<std::size_t>(state.range(1))) };
+    const Workload& workload{ cachedWorkload(shape, config) };
+    runWorkload<OrderBook>(state, workload, [&]() { return std::make_unique<OrderBook>(config); });
+}
+BENCHMARK(BM_PriceDrift)->Args({0, 0})->Args({10, 0})->Args({100, 0})->Args({100, 4096});
+
+// Full engine (reports, metrics) on a mixed flow with each trade log mode
+static void BM_EngineLogging(benchmark::State& state) {
+    const auto mode{ static_cast<LogMode>(state.range(0)) };
+    FlowShape shape{ 45, 40, 50, 0, 10000 };
+    OrderBookConfig config{ bookConfig(0.0, 10000.0) };
+    const Workload& workload{ cachedWorkload(shape, config) };
+    runWorkload<MatchingEngine>(state, workload, [&]() { return std::make_unique<MatchingEngine>(mode, config); });
+    state.SetLabel(mode == LogMode::Off ? "off" : mode == LogMode::Sync ? "sync" : "async");
+}
+BENCHMARK(BM_EngineLogging)
+    ->Arg(static_cast<int>(LogMode::Off))
+    ->Arg(static_cast<int>(LogMode::Sync))
+    ->Arg(static_cast<int>(LogMode::Async));
+
+// Market order sweeping `levels` levels of one order each. Only the sweep
+// is timed; the levels are refilled outside the measured interval.
+static void BM_MarketSweep(benchmark::State& state) {
+    const auto levels{ static_cast<uint64_t>(state.range(0)) };
+    OrderBook book(bookConfig(0.0, 10000.0));
+    uint64_t id{ 0 };
+    auto refill = [&]() {
+        for (uint64_t i = 0; i < levels; ++i)
+            book.addOrder({id++, Side::Sell, OrderType::Limit, Price{ 100.0 } + Price::fromRaw(static_cast<int64_t>(i) * 10'000), 10});
+    };
+
+    for (auto _ : state) {
+        refill();
+        Order sweep{ id++, Side::Buy, OrderType::Market, 0.0, levels * 10 };
+        auto start{ std::chrono::steady_clock::now() };
+        book.processOrder(sweep);
+        auto end{ std::chrono::steady_clock::now() };
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * levels));
+    state.counters["time_per_level"] = benchmark::Counter(static_cast<double>(state.iterations() * levels),
+                                                         benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_MarketSweep)->Arg(1)->Arg(16)->Arg(256)->Arg(4096)->UseManualTime();
+
+BENCHMARK_MAIN();
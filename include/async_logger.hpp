@@ -0,0 +1,120 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <thread>
+#include "spscqueue.hpp"
+#include "trade.hpp"
+
+enum class LogMode { Off, Sync, Async };
+
+// What the matching thread does when the ring is full
+enum class OverflowPolicy { Drop, Block };
+
+// Binary trade record copied into the ring on the matching thread
+struct TradeRecord
+{
+    uint64_t buy_id;
+    uint64_t sell_id;
+    uint64_t quantity;
+    int64_t price_raw;
+    std::chrono::steady_clock::time_point timestamp;
+};
+
+// Trade logger that keeps formatting and file I/O off the matching thread.
+// log() only copies a TradeRecord into a lock-free SPSC ring; a background
+// thread converts timestamps, formats lines in the same layout as Logger
+// ("[HH:MM:SS] TRADE  buy->sell qty=Q price=P") and writes them in batches.
+class AsyncTradeLogger
+{
+public:
+    static constexpr std::size_t kRingSize{ 1 << 14 };
+    static constexpr std::size_t kBatchSize{ 512 };
+
+    explicit AsyncTradeLogger(const std::string& filename, OverflowPolicy policy = OverflowPolicy::Drop);
+    ~AsyncTradeLogger();
+
+    AsyncTradeLogger(const AsyncTradeLogger&) = delete;
+    AsyncTradeLogger& operator=(const AsyncTradeLogger&) = delete;
+
+    // Hot path: false if the record was dropped because the ring was full
+    inline bool log(const Trade& trade) noexcept
+    {
+        TradeRecord record{ trade.buy_id, trade.sell_id, trade.quantity, trade.price.raw(), trade.timestamp };
+        if (_ring.push(record))
+        {
+            ++_accepted;
+            return true;
+        }
+        if (_policy == OverflowPolicy::Drop)
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        while (!_ring.push(record))
+            std::this_thread::yield();
+        ++_accepted;
+        return true;
+    }
+
+    // Batch of trades through one ring claim per contiguous segment.
+    // Returns how many were accepted (the rest were dropped under Drop).
+    std::size_t log(std::span<const Trade> trades) noexcept
+    {
+        std::size_t done{ 0 };
+        while (done < trades.size())
+        {
+            std::span<TradeRecord> slots{ _ring.claimWrite(trades.size() - done) };
+            if (slots.empty())
+            {
+                if (_policy == OverflowPolicy::Drop)
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+            for (TradeRecord& record : slots)
+            {
+                const Trade& trade{ trades[done++] };
+                record = { trade.buy_id, trade.sell_id, trade.quantity, trade.price.raw(), trade.timestamp };
+            }
+            _ring.commitWrite(slots.size());
+        }
+        _accepted += done;
+        _dropped.fetch_add(trades.size() - done, std::memory_order_relaxed);
+        return done;
+    }
+
+    uint64_t dropped() const noexcept { return _dropped.load(std::memory_order_relaxed); }
+    uint64_t written() const noexcept { return _written.load(std::memory_order_acquire); }
+
+    // Block until every record logged so far has been written to the file.
+    // Must be called from the logging (producer) thread.
+    void flush() const;
+
+private:
+    void run();
+    void format(const TradeRecord& record, std::string& out);
+
+    SPSCQueue<TradeRecord, kRingSize> _ring;
+    OverflowPolicy _policy;
+    std::atomic<uint64_t> _dropped{ 0 };
+    std::atomic<uint64_t> _written{ 0 };
+    uint64_t _accepted{ 0 }; // producer side only
+    std::atomic<bool> _running{ true };
+    std::ofstream _file;
+
+    // steady_clock -> system_clock offset captured once at startup
+    std::chrono::system_clock::duration _wallOffset;
+    // Cached "[HH:MM:SS] " prefix, rebuilt only when the second changes
+    std::time_t _cachedSecond{ -1 };
+    char _timePrefix[16]{};
+
+    std::thread _thread;
+};
+
+#endif // ASYNC_LOGGER_HPP
@@ -0,0 +1,130 @@
+#ifndef BOOK_POLICIES_HPP
+#define BOOK_POLICIES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include "order.hpp"
+#include "order_index.hpp"
+#include "order_pool.hpp"
+#include "trade.hpp"
+
+// Compile-time policies of BasicOrderBook. Each one is a plain class the
+// book holds by value and calls directly, so with a stateless or
+// compile-time policy the whole match path inlines.
+
+// --- Trade sink: where trades and level changes go ---------------------
+//
+//   void onTrade(const Trade&);
+//   bool wantsLevelUpdates() const;   // false skips the price conversion
+//   void onLevelUpdate(Side, Price, uint64_t quantity);
+
+// Runtime hooks (the classic OrderBook callbacks): one indirect call per
+// trade and level change while a hook is set
+class CallbackSink
+{
+public:
+    void setOnTrade(std::function<void(const Trade&)> callback) { _onTrade = std::move(callback); }
+    void setOnLevelUpdate(std::function<void(Side, Price, uint64_t)> callback) { _onLevelUpdate = std::move(callback); }
+
+    void onTrade(const Trade& trade)
+    {
+        if (_onTrade)
+            _onTrade(trade);
+    }
+    bool wantsLevelUpdates() const noexcept { return static_cast<bool>(_onLevelUpdate); }
+    void onLevelUpdate(Side side, Price price, uint64_t quantity) { _onLevelUpdate(side, price, quantity); }
+
+private:
+    std::function<void(const Trade&)> _onTrade;
+    std::function<void(Side, Price, uint64_t)> _onLevelUpdate;
+};
+
+// Trades only go to the book's trade stream
+struct NullSink
+{
+    void onTrade(const Trade&) noexcept {}
+    static constexpr bool wantsLevelUpdates() noexcept { return false; }
+    void onLevelUpdate(Side, Price, uint64_t) noexcept {}
+};
+
+// --- Price mapping: raw price units per tick ----------------------------
+//
+//   explicit Mapping(double tickSize);
+//   int64_t tick() const;
+//
+// Dense vs sparse level storage stays a run-time choice of the ladder
+// (OrderBookConfig::windowLevels).
+
+// Tick size taken from the book config
+class RuntimeTick
+{
+public:
+    explicit RuntimeTick(double tickSize) : _tick{ Price{ tickSize }.raw() }
+    {
+        if (_tick <= 0)
+            throw std::invalid_argument("tick size must be positive");
+    }
+    int64_t tick() const noexcept { return _tick; }
+
+private:
+    int64_t _tick;
+};
+
+// Tick size fixed at compile time (in raw units, see Price::kScale): index
+// arithmetic divides by a constant. The config must agree.
+template <int64_t TickRaw>
+struct FixedTick
+{
+    static_assert(TickRaw > 0);
+
+    explicit FixedTick(double tickSize)
+    {
+        if (Price{ tickSize }.raw() != TickRaw)
+            throw std::invalid_argument("tick size does not match the compile-time tick");
+    }
+    static constexpr int64_t tick() noexcept { return TickRaw; }
+};
+
+// --- Order storage: resting order nodes and the id lookup ---------------
+//
+//   explicit Storage(std::size_t capacity);
+//   uint32_t allocate(const Order&);   void release(uint32_t node);
+//   OrderNode& operator[](uint32_t node);
+//   uint32_t find(uint64_t id) const;  (npos if absent)
+//   void insert(uint64_t id, uint32_t node);  void erase(uint64_t id);
+//   void prefetch(uint64_t id) const;  void reserve(std::size_t);
+//   std::size_t size() const;
+
+// Preallocated slab with intrusive FIFO links plus the open-addressing id index
+class PooledStorage
+{
+public:
+    static constexpr uint32_t npos{ OrderPool::npos };
+
+    explicit PooledStorage(std::size_t capacity) : _pool{ capacity }, _index{ capacity } {}
+
+    uint32_t allocate(const Order& order) { return _pool.allocate(order); }
+    void release(uint32_t node) noexcept { _pool.release(node); }
+    OrderNode& operator[](uint32_t node) noexcept { return _pool[node]; }
+    const OrderNode& operator[](uint32_t node) const noexcept { return _pool[node]; }
+
+    uint32_t find(uint64_t id) const noexcept { return _index.find(id); }
+    void insert(uint64_t id, uint32_t node) { _index.insert(id, node); }
+    void erase(uint64_t id) noexcept { _index.erase(id); }
+    void prefetch(uint64_t id) const noexcept { _index.prefetch(id); }
+
+    void reserve(std::size_t capacity)
+    {
+        _pool.reserve(capacity);
+        _index.reserve(capacity);
+    }
+    std::size_t size() const noexcept { return _index.size(); }
+
+private:
+    OrderPool _pool;
+    OrderIndex _index;
+};
+
+#endif // BOOK_POLICIES_HPP
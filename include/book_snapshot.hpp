@@ -0,0 +1,56 @@
+#ifndef BOOK_SNAPSHOT_HPP
+#define BOOK_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+// On-disk layout written by OrderBook::saveSnapshot(): one header followed
+// by bidCount + askCount orders, then stopCount armed stops. Each side is
+// stored best level first and FIFO within a level (stops: buy triggers
+// then sell triggers, first to fire first), so re-adding the orders in
+// file order restores time priority exactly. Integers are in host byte
+// order.
+struct SnapshotHeader
+{
+    static constexpr uint64_t kMagic{ 0x344B4F4F42424F53 }; // "SOBBOOK4"
+
+    uint64_t magic;
+    uint64_t inputSequence; // last journal record reflected in the book
+    uint64_t tradeSequence; // next trade sequence number
+    int64_t minPrice_raw;
+    int64_t maxPrice_raw;
+    int64_t tickSize_raw;
+    uint32_t bidCount;
+    uint32_t askCount;
+    uint8_t phase;          // TradingPhase
+    uint8_t hasLastTrade;
+    uint8_t reserved[2]{};
+    uint32_t stopCount;
+    int64_t lastTrade_raw;  // last trade price
+    int64_t tradeLow_raw;   // trade range stops still trigger against (a
+    int64_t tradeHigh_raw;  // cascade cut short by maxStopCascade)
+};
+
+struct SnapshotOrder
+{
+    uint64_t id;
+    int64_t price_raw;
+    uint64_t quantity;
+    uint32_t instrument;
+    uint8_t type; // OrderType
+    uint8_t reserved[3]{};
+};
+
+struct SnapshotStop
+{
+    SnapshotOrder order;
+    int64_t stop_raw;
+    uint8_t side; // Side
+    uint8_t reserved[7]{};
+};
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader> && sizeof(SnapshotHeader) == 88);
+static_assert(std::is_trivially_copyable_v<SnapshotOrder> && sizeof(SnapshotOrder) == 32);
+static_assert(std::is_trivially_copyable_v<SnapshotStop> && sizeof(SnapshotStop) == 48);
+
+#endif // BOOK_SNAPSHOT_HPP
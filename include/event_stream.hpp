@@ -0,0 +1,110 @@
+#ifndef EVENT_STREAM_HPP
+#define EVENT_STREAM_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Bounded, sequenced output stream owned by a single (matching) thread.
+// Every published event gets the next sequence number starting at 0. Only
+// the most recent `retention` events are kept: storage is allocated once up
+// front and the oldest event is overwritten when the ring is full, so
+// memory stays flat however long the session runs. Retention 0 keeps
+// nothing and only counts sequences.
+//
+// Indexing ([], front, back, size) covers the retained window oldest
+// first; consumers that need every event drain with poll() and a cursor.
+// Indexing outside the window (always, with retention 0) is a caller bug:
+// it asserts, and in release builds still reads inside the ring (at least
+// one slot is allocated) but returns a stale or empty event.
+template <typename T>
+class EventStream
+{
+public:
+    static constexpr std::size_t kDefaultRetention{ 1 << 16 };
+
+    explicit EventStream(std::size_t retention = kDefaultRetention)
+        : _capacity{ std::bit_ceil(retention) }, // 1 for retention 0
+            _retention{ retention }, _mask{ _capacity - 1 }, _events(_capacity)
+    {
+    }
+
+    // Hot path: no allocation, returns the event's sequence number
+    inline uint64_t publish(const T& event) noexcept
+    {
+        if (_retention != 0)
+            _events[_next & _mask] = event;
+        return _next++;
+    }
+
+    // Publish a batch in order; returns the sequence of the first event.
+    // Only the last events that fit the ring are copied.
+    uint64_t publish(std::span<const T> events) noexcept
+    {
+        uint64_t first{ _next };
+        if (_retention != 0 && !events.empty())
+        {
+            std::size_t skip{ events.size() > _capacity ? events.size() - _capacity : 0 };
+            std::size_t slot{ (_next + skip) & _mask };
+            std::size_t count{ events.size() - skip };
+            std::size_t head{ count < _capacity - slot ? count : _capacity - slot };
+            std::copy_n(events.begin() + skip, head, _events.begin() + slot);
+            std::copy_n(events.begin() + skip + head, count - head, _events.begin());
+        }
+        _next += events.size();
+        return first;
+    }
+
+    // Sequence the next event will get (= events published so far)
+    uint64_t nextSequence() const noexcept { return _next; }
+    // Oldest sequence still retained
+    uint64_t firstSequence() const noexcept { return _next - size(); }
+
+    std::size_t size() const noexcept { return _next - _start < _retention ? _next - _start : _retention; }
+    bool empty() const noexcept { return size() == 0; }
+    std::size_t retention() const noexcept { return _retention; }
+
+    const T& operator[](std::size_t i) const noexcept
+    {
+        assert(i < size() && "EventStream index outside the retained window");
+        return _events[(firstSequence() + i) & _mask];
+    }
+    const T& front() const noexcept { return (*this)[0]; }
+    const T& back() const noexcept
+    {
+        assert(!empty() && "EventStream::back() on an empty window");
+        return _events[(_next - 1) & _mask];
+    }
+
+    // Pass every retained event with sequence >= cursor to handler(seq, event)
+    // and advance cursor past them. Events that already fell out of the
+    // window are skipped; the caller sees the gap in the sequence numbers.
+    template <typename Handler>
+    std::size_t poll(uint64_t& cursor, Handler&& handler) const
+    {
+        if (cursor < firstSequence())
+            cursor = firstSequence();
+        std::size_t count{ 0 };
+        for (; cursor < _next; ++cursor, ++count)
+            handler(cursor, _events[cursor & _mask]);
+        return count;
+    }
+
+    // Continue numbering at next (e.g. after restoring from a snapshot);
+    // retained events are dropped
+    void resume(uint64_t next) noexcept { _next = next; _start = next; }
+
+private:
+    std::size_t _capacity;
+    std::size_t _retention;
+    std::size_t _mask;
+    uint64_t _next{ 0 };
+    uint64_t _start{ 0 }; // first sequence published by this instance
+    std::vector<T> _events;
+};
+
+#endif // EVENT_STREAM_HPP
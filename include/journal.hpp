@@ -0,0 +1,132 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "order.hpp"
+
+enum class JournalKind : uint8_t { New, Cancel, Reduce, Replace, Auction, Uncross };
+
+// One engine input, fixed size so the file can be read back in bulk.
+// New: the order fields (stop_raw for stop orders). Cancel: targetId. Reduce: targetId and the new
+// quantity. Replace: targetId plus the replacement order fields.
+// Auction / Uncross: no fields, the call phase starts / the book uncrosses.
+struct JournalRecord
+{
+    uint64_t sequence;
+    JournalKind kind;
+    uint8_t side;  // Side
+    uint8_t type;  // OrderType
+    uint8_t reserved{ 0 };
+    InstrumentId instrument;
+    uint64_t id;
+    uint64_t targetId;
+    int64_t price_raw;
+    uint64_t quantity;
+    int64_t stop_raw{ 0 };
+
+    static JournalRecord fromOrder(uint64_t sequence, JournalKind kind, const Order& order, uint64_t targetId = 0)
+    {
+        return { sequence, kind, static_cast<uint8_t>(order.side), static_cast<uint8_t>(order.type), 0,
+                 order.instrument, order.id, targetId, order.price.raw(), order.quantity, order.stopPrice.raw() };
+    }
+
+    Order toOrder() const
+    {
+        Order order{ id, static_cast<Side>(side), static_cast<OrderType>(type), Price::fromRaw(price_raw), quantity, instrument };
+        order.stopPrice = Price::fromRaw(stop_raw);
+        return order;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<JournalRecord> && sizeof(JournalRecord) == 56);
+
+// First bytes of a journal or order file; a file whose header does not
+// match this build's record layout is refused rather than misread.
+// Version 1 is the 56-byte record with stop_raw. Files from before the
+// header (48-byte records, no stop price) start with a sequence number
+// instead of the magic and are refused as well; regenerate them.
+struct JournalFileHeader
+{
+    static constexpr uint64_t kMagic{ 0x4E52554F4A424F53 }; // "SOBJOURN"
+    static constexpr uint32_t kVersion{ 1 };
+
+    uint64_t magic{ kMagic };
+    uint32_t version{ kVersion };
+    uint32_t recordSize{ sizeof(JournalRecord) };
+
+    bool matches() const noexcept
+    {
+        return magic == kMagic && version == kVersion && recordSize == sizeof(JournalRecord);
+    }
+};
+
+static_assert(sizeof(JournalFileHeader) == 16);
+
+// Append-only input journal: a JournalFileHeader, then the records.
+// Records are buffered by the stream and reach the file on flush() or when
+// the buffer fills; a record torn by a crash is ignored on replay and cut
+// off when the journal is reopened.
+class Journal
+{
+public:
+    // Opens (or creates) the file for appending, throws std::runtime_error on failure
+    // or if the file has a different format. A torn last record is truncated first.
+    explicit Journal(const std::string& path);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    void append(const JournalRecord& record)
+    {
+        _file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    void flush() { _file.flush(); }
+
+    // handler(const JournalRecord&) for every record with sequence >= from.
+    // Returns the last sequence seen in the file (0 if none or no file).
+    // Throws std::runtime_error if the file header does not match.
+    template <typename Handler>
+    static uint64_t replay(const std::string& path, uint64_t from, Handler&& handler);
+
+private:
+    std::ofstream _file;
+};
+
+template <typename Handler>
+uint64_t Journal::replay(const std::string& path, uint64_t from, Handler&& handler)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return 0;
+    JournalFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (static_cast<std::size_t>(file.gcount()) < sizeof(header))
+        return 0; // empty, or the header itself was torn
+    if (!header.matches())
+        throw std::runtime_error("unsupported journal format in " + path);
+
+    constexpr std::size_t kChunk{ 4096 };
+    std::vector<JournalRecord> records(kChunk);
+    uint64_t last{ 0 };
+    for (;;)
+    {
+        file.read(reinterpret_cast<char*>(records.data()), kChunk * sizeof(JournalRecord));
+        std::size_t count{ static_cast<std::size_t>(file.gcount()) / sizeof(JournalRecord) };
+        for (std::size_t i{ 0 }; i < count; ++i)
+        {
+            last = records[i].sequence;
+            if (last >= from)
+                handler(records[i]);
+        }
+        if (count < kChunk)
+            return last;
+    }
+}
+
+#endif // JOURNAL_HPP
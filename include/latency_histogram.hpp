@@ -0,0 +1,117 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Copy of a histogram taken at one point in time
+struct HistogramSnapshot
+{
+    static constexpr std::size_t kSubBits{ 5 };
+    static constexpr std::size_t kSubBuckets{ std::size_t{ 1 } << kSubBits };
+    static constexpr std::size_t kBuckets{ kSubBuckets + (64 - kSubBits) * kSubBuckets };
+
+    std::array<uint64_t, kBuckets> counts{};
+    uint64_t count{ 0 };
+    uint64_t max{ 0 };
+
+    // Upper bound of the bucket holding the p-th percentile (p in [0, 100])
+    uint64_t percentile(double p) const noexcept
+    {
+        if (count == 0)
+            return 0;
+        uint64_t rank{ static_cast<uint64_t>(p / 100.0 * static_cast<double>(count) + 0.5) };
+        if (rank == 0)
+            rank = 1;
+        uint64_t seen{ 0 };
+        for (std::size_t i{ 0 }; i < kBuckets; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(highestEquivalent(i), max);
+        }
+        return max;
+    }
+
+    // Log-linear bucketing: values below 32 are exact, every power of two
+    // above is split into 32 sub-buckets (relative error below 1/32)
+    static constexpr std::size_t bucketOf(uint64_t value) noexcept
+    {
+        if (value < kSubBuckets)
+            return static_cast<std::size_t>(value);
+        std::size_t msb{ 63 - static_cast<std::size_t>(std::countl_zero(value)) };
+        std::size_t shift{ msb - kSubBits };
+        return kSubBuckets + shift * kSubBuckets + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+    }
+
+    static constexpr uint64_t highestEquivalent(std::size_t bucket) noexcept
+    {
+        if (bucket < kSubBuckets)
+            return bucket;
+        std::size_t shift{ (bucket - kSubBuckets) / kSubBuckets };
+        uint64_t sub{ (bucket - kSubBuckets) % kSubBuckets + kSubBuckets };
+        return ((sub + 1) << shift) - 1;
+    }
+};
+
+// HDR-style latency histogram with a single writer. The writer bumps
+// counters with relaxed load/store (no locked instructions); any other
+// thread may take a snapshot or reset while recording continues.
+class LatencyHistogram
+{
+public:
+    inline void record(uint64_t value) noexcept
+    {
+        auto& bucket{ _counts[HistogramSnapshot::bucketOf(value)] };
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        _count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value > _max.load(std::memory_order_relaxed))
+            _max.store(value, std::memory_order_relaxed);
+    }
+
+    // Counts recorded since the last reset()
+    HistogramSnapshot snapshot() const noexcept
+    {
+        HistogramSnapshot snap;
+        for (std::size_t i{ 0 }; i < HistogramSnapshot::kBuckets; ++i)
+        {
+            snap.counts[i] = _counts[i].load(std::memory_order_relaxed) - _baseline.counts[i];
+            snap.count += snap.counts[i];
+        }
+        snap.max = _max.load(std::memory_order_relaxed);
+        return snap;
+    }
+
+    // Reader side: the writer is never stopped, the current counts simply
+    // become the new baseline. A max recorded concurrently with reset() may
+    // be lost, which only affects that one value.
+    void reset() noexcept
+    {
+        for (std::size_t i{ 0 }; i < HistogramSnapshot::kBuckets; ++i)
+            _baseline.counts[i] = _counts[i].load(std::memory_order_relaxed);
+        _max.store(0, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot snapshotAndReset() noexcept
+    {
+        HistogramSnapshot snap{ snapshot() };
+        for (std::size_t i{ 0 }; i < HistogramSnapshot::kBuckets; ++i)
+            _baseline.counts[i] += snap.counts[i];
+        _max.store(0, std::memory_order_relaxed);
+        return snap;
+    }
+
+    uint64_t totalCount() const noexcept { return _count.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<uint64_t>, HistogramSnapshot::kBuckets> _counts{};
+    std::atomic<uint64_t> _count{ 0 };
+    std::atomic<uint64_t> _max{ 0 };
+    HistogramSnapshot _baseline; // owned by the reader
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -13,9 +13,7 @@ class Logger
 public:
     Logger(const std::string& filename)
     {
-        std::filesystem::path logDir = std::filesystem::current_path().parent_path() / "logs";
-        std::filesystem::create_directories(logDir);
-        std::filesystem::path logFile = logDir / filename;
+        std::filesystem::path logFile = resolvePath(filename);
 
         _file.open(logFile, std::ios::out | std::ios::app);
         if (!_file.is_open())
@@ -24,6 +22,14 @@ public:
             std::cout << "[Logger] Logging to: " << logFile << std::endl;
     }   
 
+    // logs/<filename> next to the build directory, created on demand
+    static std::filesystem::path resolvePath(const std::string& filename)
+    {
+        std::filesystem::path logDir = std::filesystem::current_path().parent_path() / "logs";
+        std::filesystem::create_directories(logDir);
+        return logDir / filename;
+    }
+
     template <typename... Args>
     void log(const std::string& fmt, Args&&... args)
     {
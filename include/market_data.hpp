@@ -0,0 +1,112 @@
+#ifndef MARKET_DATA_HPP
+#define MARKET_DATA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "order_book.hpp"
+#include "order_index.hpp"
+#include "spscqueue.hpp"
+
+// Incremental L2 update: new aggregate quantity at one price (0 = level gone)
+struct LevelUpdate
+{
+    uint64_t sequence;
+    Side side;
+    Price price;
+    uint64_t quantity;
+};
+
+// Full depth (up to the publisher's snapshot depth), best level first.
+// Updates with a sequence greater than `sequence` apply on top of it.
+struct DepthSnapshot
+{
+    uint64_t sequence{ 0 };
+    std::vector<DepthLevel> bids;
+    std::vector<DepthLevel> asks;
+};
+
+// L2 market data for one OrderBook. The book reports every level change on
+// the matching thread; the publisher forwards it through an SPSC ring to a
+// single consumer thread. When the consumer falls behind and the ring is
+// full, updates are conflated per level (only the latest quantity is kept)
+// and sent once there is room again, so the matching thread never waits.
+//
+// Every snapshotInterval updates a full-depth snapshot is also written to a
+// seqlock-protected buffer that any thread can copy with readSnapshot().
+class MarketDataPublisher
+{
+public:
+    static constexpr std::size_t kQueueSize{ 1 << 12 };
+
+    // Installs the book's level update callback; the book must outlive us
+    explicit MarketDataPublisher(OrderBook& book, std::size_t snapshotDepth = 256,
+                                 uint64_t snapshotInterval = 1024);
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    // Matching thread
+    void onLevelUpdate(Side side, Price price, uint64_t quantity) noexcept;
+    // Retry sending conflated levels; call when the matching thread is idle
+    void flush() noexcept;
+    void publishSnapshot() noexcept;
+
+    // Consumer thread: handler(const LevelUpdate&) for up to maxSize updates
+    template <typename Handler>
+    std::size_t poll(Handler&& handler, std::size_t maxSize = kQueueSize)
+    {
+        std::size_t total{ 0 };
+        while (total < maxSize)
+        {
+            std::span<LevelUpdate> updates{ _updates.claimRead(maxSize - total) };
+            if (updates.empty())
+                break;
+            for (const LevelUpdate& update : updates)
+                handler(update);
+            _updates.commitRead(updates.size());
+            total += updates.size();
+        }
+        return total;
+    }
+
+    // Any thread: copy of the latest snapshot, false if none was published yet
+    bool readSnapshot(DepthSnapshot& out) const;
+
+    // Updates that replaced an unsent update for the same level
+    uint64_t conflated() const noexcept { return _conflated.load(std::memory_order_relaxed); }
+    // Matching thread: levels waiting for room in the ring
+    std::size_t pendingLevels() const noexcept { return _pending.size() - _pendingHead; }
+
+private:
+    static uint64_t key(Side side, Price price) noexcept
+    {
+        return static_cast<uint64_t>(price.raw()) << 1 | (side == Side::Sell ? 1 : 0);
+    }
+
+    bool send(Side side, Price price, uint64_t quantity) noexcept;
+
+    OrderBook& _book;
+    SPSCQueue<LevelUpdate, kQueueSize> _updates;
+    uint64_t _sequence{ 0 };
+
+    // Conflation: latest unsent quantity per level, in first-conflated order
+    std::vector<LevelUpdate> _pending;
+    std::size_t _pendingHead{ 0 };
+    OrderIndex _pendingIndex; // level key -> position in _pending
+    std::atomic<uint64_t> _conflated{ 0 };
+
+    // Seqlock snapshot: odd version while the matching thread is writing
+    std::size_t _snapshotDepth;
+    uint64_t _snapshotInterval;
+    uint64_t _sinceSnapshot{ 0 };
+    std::atomic<uint64_t> _snapshotVersion{ 0 };
+    std::atomic<uint64_t> _snapshotSequence{ 0 };
+    std::atomic<std::size_t> _snapshotBids{ 0 };
+    std::atomic<std::size_t> _snapshotAsks{ 0 };
+    std::vector<DepthLevel> _bidLevels;
+    std::vector<DepthLevel> _askLevels;
+};
+
+#endif // MARKET_DATA_HPP
@@ -2,42 +2,159 @@
 #define MATCHING_ENGINE
 
 #include "order_book.hpp"
-#include <string>
+#include <ostream>
 #include "logger.hpp"
+#include "async_logger.hpp"
+#include "latency_histogram.hpp"
+#include "tsc_clock.hpp"
+#include "event_stream.hpp"
+#include "journal.hpp"
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
 
+enum class ExecStatus : uint8_t
+{
+    Accepted,
+    Filled,
+    PartiallyFilled,
+    Rejected,
+    Canceled,
+    Reduced,
+    Replaced,
+    CancelRejected,
+    ReduceRejected,
+    ReplaceRejected
+};
+
+// accepted, filled, partially_filled, rejected, canceled, reduced, replaced,
+// cancel_rejected, reduce_rejected, replace_rejected
+const char* toString(ExecStatus status) noexcept;
+std::ostream& operator<<(std::ostream& os, ExecStatus status);
+
+// Fixed-size, trivially copyable: can be copied into a ring or journal as is
 struct ExecutionReport
 {
     uint64_t id;
-    std::string status; // accepted, filled, partially_filled, rejected
-    double price;
-    uint64_t quantity; 
+    ExecStatus status;
+    Price price;            // order (or resting order) price
+    uint64_t quantity;      // order quantity the report refers to
+    uint64_t filledQty{ 0 };
+    uint64_t leavesQty{ 0 }; // quantity left resting in the book
+    Price avgFillPrice{ 0.0 };
 };
 
-struct Metrics 
+static_assert(std::is_trivially_copyable_v<ExecutionReport>);
+
+// Default report sink: keeps the most recent reports, see EventStream
+using ReportStream = EventStream<ExecutionReport>;
+
+// Written by the matching thread, readable from any thread while it runs.
+// Latencies are recorded in TscClock ticks, see TscClock::toNanos().
+struct Metrics
 {
-    uint64_t processed_orders = 0;
-    uint64_t executed_trades = 0;
-    double avg_latency_us = 0.0;
+    std::atomic<uint64_t> processed_orders{ 0 };
+    std::atomic<uint64_t> executed_trades{ 0 };
+    LatencyHistogram add_latency;   // limit orders that rest without trading
+    LatencyHistogram sweep_latency; // market orders
+    LatencyHistogram match_latency; // limit orders that trade
+    LatencyHistogram batch_latency; // processBatchOrders: one amortized per-order sample per batch
 };
 
-class MatchingEngine
+// Reports are handed to Sink::publish(const ExecutionReport&) on the
+// matching thread. Any type with that member works: a bounded stream (the
+// default), a queue adapter, a journal writer. A sink that also has
+// publish(std::span<const ExecutionReport>) gets a batch's reports at once.
+template <typename Sink>
+class BasicMatchingEngine
 {
 public:
-    MatchingEngine();
+    // Sink is constructed from sinkArgs (for ReportStream: the retention)
+    template <typename... SinkArgs>
+    explicit BasicMatchingEngine(LogMode logMode = LogMode::Async, const OrderBookConfig& bookConfig = {},
+                                 SinkArgs&&... sinkArgs);
+    // Orders the book cannot take (OrderBook::acceptsOrder: zero quantity,
+    // price off the grid or out of range) are journaled and answered with
+    // Rejected on every entry path, replace included (ReplaceRejected, the
+    // original order stays: replaceOrder returns false)
     void processOrder(Order order) noexcept;
-    void processBatchOrders(const std::vector<Order>& orders);
-    const auto& getReports() const noexcept { return _reports; }
+    // Batch path: one clock read for the whole batch (stamped on every trade),
+    // the next orders' levels prefetched while matching, and the batch's
+    // reports and logged trades handed on in one call each. Matches exactly
+    // like calling processOrder for each order in turn.
+    void processBatchOrders(std::span<const Order> orders);
+    void cancelOrder(uint64_t id) noexcept;
+    // Rejected report for an order refused before matching (e.g. by risk);
+    // the order is not journaled and never reaches the book
+    void rejectOrder(const Order& order) noexcept;
+    void reduceOrder(uint64_t id, uint64_t newQuantity) noexcept;
+    bool replaceOrder(uint64_t id, Order replacement) noexcept;
+    // Call auction (see OrderBook::startAuction). Both are journaled inputs;
+    // the uncross trades go to the trade log like any other
+    void startAuction() noexcept;
+    AuctionResult uncross() noexcept;
+    // Dispatch one recorded input (journal / order file record)
+    void apply(const JournalRecord& record) noexcept;
+    const Sink& getReports() const noexcept { return _reports; }
+    Sink& getReports() noexcept { return _reports; }
     const auto& getOrderBook() const noexcept { return _orderBook; }
+    // Requires a sink with poll(), like ReportStream
     void printReports() const noexcept;
+    const Metrics& getMetrics() const noexcept { return _metrics; }
+    Metrics& getMetrics() noexcept { return _metrics; }
+    // p50/p99/p99.9/max per order class, in nanoseconds
+    void printMetrics() const;
+    // Wait until the trade log has caught up (async mode)
+    void flushLog() const;
+    // Trade records dropped because the async log ring was full
+    uint64_t droppedLogRecords() const noexcept { return _asyncLogger ? _asyncLogger->dropped() : 0; }
+
+    // Append every subsequent input (new/cancel/reduce/replace) to the journal at path
+    void openJournal(const std::string& path);
+    // Book snapshot tagged with the last input sequence; flushes the journal first
+    void saveSnapshot(const std::string& path);
+    // Restart: load the snapshot (if the file exists) into this fresh engine,
+    // then replay only the journal records after it. Replayed inputs go
+    // through the normal path and produce reports again. Returns the last
+    // input sequence applied.
+    uint64_t recover(const std::string& snapshotPath, const std::string& journalPath);
+    uint64_t inputSequence() const noexcept { return _inputSequence; }
 
 
 private:
+    // Single writer: plain load/store keeps locked instructions off the hot path
+    static void bump(std::atomic<uint64_t>& counter, uint64_t by) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+    // Number the input and append it to the journal if one is open
+    void journal(JournalRecord record);
+    void execute(Order order) noexcept;
+    // Report for the order the book just processed
+    ExecutionReport fillReport(const Order& order) const noexcept;
+    // Report for a stop the book triggered while processing it
+    ExecutionReport activationReport(const StopActivation& activation) const noexcept;
+
     OrderBook _orderBook;
-    Logger _logger{ "trades.log" };
-    std::vector<ExecutionReport> _reports;
+    std::unique_ptr<Logger> _logger;
+    std::unique_ptr<AsyncTradeLogger> _asyncLogger;
+    Sink _reports;
     Metrics _metrics;
+    std::unique_ptr<Journal> _journal;
+    uint64_t _inputSequence{ 0 };
+
+    // Batch buffers, reused between batches
+    std::vector<ExecutionReport> _batchReports;
+    std::vector<Trade> _batchTrades;
 };
 
+#include "../src/matching_engine.tpp"
+
+using MatchingEngine = BasicMatchingEngine<ReportStream>;
+
+// Instantiated once in matching_engine.cpp
+extern template class BasicMatchingEngine<ReportStream>;
 
-#endif // MATCHING_ENGINE
\ No newline at end of file
+#endif // MATCHING_ENGINE
@@ -0,0 +1,66 @@
+#ifndef MPSCQUEUE_HPP
+#define MPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+// Bounded lock-free multi-producer/single-consumer ring (Vyukov style).
+// Every slot carries a sequence number: a producer claims position p with a
+// CAS on the shared head once the slot's sequence equals p, writes the item
+// and publishes it by storing p + 1. The consumer owns the tail outright and
+// hands the slot back to producers by storing p + N. Producers never wait on
+// each other beyond a failed CAS, and a stalled producer only holds up the
+// consumer at its own slot.
+template <typename T, std::size_t N>
+class MPSCQueue
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MPSCQueue capacity must be a power of two");
+
+public:
+    static constexpr std::size_t kCapacity{ N };
+
+    MPSCQueue();
+
+    // Any thread
+    bool push(const T& item);
+
+    // Consumer thread only
+    bool pop(T& item);
+    std::size_t popBatch(std::vector<T>& out, std::size_t maxSize);
+
+    // Drain up to maxSize published items in order, passing each one to
+    // handler in place before its slot is released. Stops at the first slot
+    // that is not published yet.
+    template <typename Handler>
+    std::size_t consume(Handler&& handler, std::size_t maxSize);
+
+    // Approximate when producers are active
+    std::size_t size() const noexcept
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr std::size_t kMask{ N - 1 };
+    static constexpr std::size_t kCacheLine{ 64 };
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    // Shared by all producers
+    alignas(kCacheLine) std::atomic<std::size_t> _head{};
+    // Written by the consumer only; atomic so size() may be read elsewhere
+    alignas(kCacheLine) std::atomic<std::size_t> _tail{};
+
+    alignas(kCacheLine) std::array<Slot, N> _slots;
+};
+
+#include "../src/mpscqueue.tpp"
+
+#endif // MPSCQUEUE_HPP
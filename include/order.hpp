@@ -3,23 +3,34 @@
 
 #include <stdint.h>
 #include <chrono>
+#include "price.hpp"
+
+using InstrumentId = uint32_t;
+using AccountId = uint32_t;
 
 enum class Side { Buy, Sell };
-enum class OrderType { Limit, Market };
+// Stop and StopLimit wait in the book's trigger buckets until a trade
+// reaches stopPrice (at or above it for a buy, at or below for a sell),
+// then enter as Market and Limit orders respectively
+enum class OrderType { Limit, Market, Stop, StopLimit };
 
 struct Order
 {
     uint64_t id;
     Side side;
     OrderType type;
-    double price;
+    Price price;
     uint64_t quantity;
-    std::chrono::steady_clock::time_point timestamp{ std::chrono::steady_clock::now() };
+    std::chrono::steady_clock::time_point timestamp{}; // set by the converting constructor, not by Order()
+    InstrumentId instrument{ 0 };
+    AccountId account{ 0 };
+    Price stopPrice{ 0.0 }; // Stop / StopLimit trigger
 
     Order() = default;
-    Order(uint64_t _id, Side _side, OrderType _type, double _price, uint64_t _qty)
+    Order(uint64_t _id, Side _side, OrderType _type, Price _price, uint64_t _qty, InstrumentId _instrument = 0,
+          AccountId _account = 0)
         : id{ _id }, side{ _side }, type{ _type }, price{ _price }, quantity{ _qty },
-            timestamp{ std::chrono::steady_clock::now() }
+            timestamp{ std::chrono::steady_clock::now() }, instrument{ _instrument }, account{ _account }
     {
     } 
 };
@@ -1,70 +1,370 @@
 #ifndef ORDER_BOOK_HPP
 #define ORDER_BOOK_HPP
 
-#include <deque>
+#include <algorithm>
 #include <functional>
 #include <optional>
 #include "order.hpp"
 #include "trade.hpp"
+#include "price_ladder.hpp"
+#include "order_pool.hpp"
+#include "order_index.hpp"
+#include "event_stream.hpp"
+#include "book_policies.hpp"
+#include <span>
 #include <vector>
-#include <memory>
-#include <functional>
+#include <string>
+
+struct OrderBookConfig
+{
+    double minPrice = 0.0;
+    double maxPrice = 10000.0;
+    double tickSize = 0.01;
+    std::size_t orderCapacity = 1 << 16;  // resting orders preallocated in the pool
+    std::size_t windowLevels = 0;         // dense levels kept around the mid, 0 = whole range
+    std::size_t tradeRetention = 1 << 16; // most recent trades kept by getTrades(), 0 = none
+    std::size_t maxStopCascade = 64;      // stop activations per processed order, the rest fire after the next one
+};
+
+// Aggregate of one price level
+struct DepthLevel
+{
+    Price price;
+    uint64_t quantity;
+    uint64_t orders{ 0 };
+};
 
-class OrderBook
+// What an incoming order would take from the opposite side: filled
+// quantity, sum of price.raw() * quantity and the levels it reaches
+struct FillEstimate
 {
-public:  
-    OrderBook(double minPrice = 0.0, double maxPrice = 10000.0, double tickSize = 0.01)
-        : _minPrice{ minPrice }, _maxPrice{ maxPrice }, _tickSize{ tickSize }
+    uint64_t quantity{ 0 };
+    int64_t notional{ 0 };
+    std::size_t levels{ 0 };
+    bool saturated{ false }; // notional hit the int64 limit, vwap() is not exact
+
+    // Volume-weighted average fill price, 0 if nothing fills
+    Price vwap() const noexcept { return averagePrice(notional, quantity); }
+};
+
+// A stop order the last trade triggered: what it entered as (Market or
+// Limit) and how it executed
+struct StopActivation
+{
+    uint64_t id;
+    OrderType type;
+    Price price;
+    uint64_t quantity;
+    uint64_t filledQty;
+    int64_t fillNotional; // sum of price.raw() * quantity, saturating
+    uint64_t leavesQty;   // left resting (Limit), 0 for a Market remainder
+};
+
+enum class TradingPhase : uint8_t { Continuous, Auction };
+
+// Equilibrium of a call auction: the price that executes the most volume,
+// ties broken by the smallest imbalance. volume 0 = the book does not cross.
+struct AuctionResult
+{
+    Price price{ 0.0 };
+    uint64_t volume{ 0 };
+    int64_t imbalance{ 0 }; // buy minus sell quantity left unmatched at price
+};
+
+// Limit order book over compile-time policies (see book_policies.hpp):
+// where trades and level updates go, how prices map to ticks, and how
+// resting orders are stored. OrderBook below is the run-time configurable
+// default; e.g. BasicOrderBook<NullSink, FixedTick<10'000>> drops every
+// indirect call and division by a run-time tick from the match path.
+template <typename TradeSink = CallbackSink, typename PriceMapping = RuntimeTick, typename Storage = PooledStorage>
+class BasicOrderBook
+{
+public:
+    BasicOrderBook(double minPrice = 0.0, double maxPrice = 10000.0, double tickSize = 0.01)
+        : BasicOrderBook(OrderBookConfig{ minPrice, maxPrice, tickSize })
+    {
+    }
+
+    explicit BasicOrderBook(const OrderBookConfig& config)
+        : _minPrice{ config.minPrice }, _maxPrice{ config.maxPrice }, _mapping{ config.tickSize },
+            _numPriceLevels{ static_cast<size_t>((_maxPrice - _minPrice).raw() / _mapping.tick()) + 1 },
+            _orders{ config.orderCapacity },
+            _bids{ Side::Buy, _numPriceLevels, config.windowLevels },
+            _asks{ Side::Sell, _numPriceLevels, config.windowLevels },
+            _buyStops{ Side::Sell, _numPriceLevels, config.windowLevels },
+            _sellStops{ Side::Buy, _numPriceLevels, config.windowLevels },
+            _trades{ config.tradeRetention }, _maxStopCascade{ config.maxStopCascade }
     {
-        _numPriceLevels = static_cast<size_t>((maxPrice - minPrice) / tickSize) + 1;
-        _bids.resize(_numPriceLevels);
-        _asks.resize(_numPriceLevels);
     }
 
-    void processOrder(Order order);
+    void processOrder(Order order) { processOrder(order, std::chrono::steady_clock::now()); }
+    // Same, with the timestamp stamped on every trade (one clock read per batch)
+    void processOrder(Order order, std::chrono::steady_clock::time_point timestamp);
     void addOrder(const Order& order) noexcept;
+
+    // Stop and StopLimit orders are armed in per-tick trigger buckets, one
+    // ladder per side next to the bid/ask ladders: buy stops ordered lowest
+    // trigger first, sell stops highest first. After every processed order
+    // (and uncross) the bucket heads are compared with the last trade
+    // price, so only the buckets the price moved through are touched.
+    // Triggered orders run through the normal match path one at a time,
+    // buy stops before sell stops and FIFO within a bucket; each can move
+    // the price and trigger more. Triggers are tested against the highest
+    // (buy stops) and lowest (sell stops) trade price since the last
+    // complete pass, not just the last trade. At most maxStopCascade
+    // activations run per call; any further ones stay armed with that
+    // trade range kept and fire after the next order (or uncross), even if
+    // the price has moved back through their trigger meanwhile.
+    // Cancel and reduce work on armed stops like on resting orders.
+
+    // Remove a resting order or an armed stop. Returns false if the id is not in the book
+    bool cancelOrder(uint64_t id) noexcept;
+    // Lower the resting quantity keeping time priority (0 cancels the order)
+    bool reduceOrder(uint64_t id, uint64_t newQuantity) noexcept;
+    // Cancel the resting order and submit the replacement as a new order
+    bool replaceOrder(uint64_t id, Order replacement);
+    // Resting order or armed stop by id, nullptr if absent
+    const Order* findOrder(uint64_t id) const noexcept;
+    // Inside [minPrice, maxPrice] and on the tick grid
+    bool onGrid(Price price) const noexcept
+    {
+        return price >= _minPrice && price <= _maxPrice && (price - _minPrice).raw() % _mapping.tick() == 0;
+    }
+    // Positive quantity and every price the order uses on the grid (limit
+    // price of Limit / StopLimit, trigger of Stop / StopLimit; a market
+    // order's price is ignored). The quantity must also keep maxPrice.raw()
+    // * quantity inside int64: any order can fill up to maxPrice, and fill
+    // notionals are summed in raw units. processOrder() itself does not
+    // check: an off-grid price would be truncated to a neighbouring level.
+    bool acceptsOrder(const Order& order) const noexcept
+    {
+        bool limitPrice{ order.type == OrderType::Limit || order.type == OrderType::StopLimit };
+        bool stopPrice{ order.type == OrderType::Stop || order.type == OrderType::StopLimit };
+        int64_t notional;
+        return order.quantity > 0 && !__builtin_mul_overflow(_maxPrice.raw(), order.quantity, &notional)
+            && (!limitPrice || onGrid(order.price)) && (!stopPrice || onGrid(order.stopPrice));
+    }
     void printBook() const noexcept;
-    const std::vector<Trade>& getTrades() const noexcept { return _trades; }
+    const EventStream<Trade>& getTrades() const noexcept { return _trades; }
     const Order getLastOrder() const noexcept { return _lastOrder; };
-    void setOnTradeCallback(std::function<void(const Trade&)> callback) {
-        _onTradeCallback = std::move(callback);
+    // Fills of the last processed order: quantity and sum of price.raw() *
+    // quantity (saturating, see addNotional; acceptsOrder keeps it exact)
+    uint64_t lastFillQty() const noexcept { return _fillQty; }
+    int64_t lastFillNotional() const noexcept { return _fillNotional; }
+    // Stops triggered by the last processed order or uncross, in firing order
+    const std::vector<StopActivation>& lastActivations() const noexcept { return _activations; }
+    std::optional<Price> lastTradePrice() const noexcept
+    {
+        return _hasLastTrade ? std::optional<Price>{ _lastTrade } : std::nullopt;
     }
+    std::optional<Price> bestBid() const noexcept
+    {
+        return _bids.best() == PriceLadder::npos ? std::nullopt : std::optional<Price>{ indexToPrice(_bids.best()) };
+    }
+    std::optional<Price> bestAsk() const noexcept
+    {
+        return _asks.best() == PriceLadder::npos ? std::nullopt : std::optional<Price>{ indexToPrice(_asks.best()) };
+    }
+    const PriceLadder& getBids() const noexcept { return _bids; }
+    const PriceLadder& getAsks() const noexcept { return _asks; }
 
-private:
-    inline size_t priceToIndex(double price) const noexcept {
-        return static_cast<size_t>((price - _minPrice) / _tickSize);
+    TradeSink& tradeSink() noexcept { return _sink; }
+    const TradeSink& tradeSink() const noexcept { return _sink; }
+    void setOnTradeCallback(std::function<void(const Trade&)> callback)
+        requires requires(TradeSink& sink) { sink.setOnTrade(std::function<void(const Trade&)>{}); }
+    {
+        _sink.setOnTrade(std::move(callback));
     }
-    
-    inline double indexToPrice(size_t index) const noexcept {
-        return _minPrice + (index * _tickSize);
+    // Called with the new aggregate quantity whenever a level changes (0 = level removed)
+    void setOnLevelUpdateCallback(std::function<void(Side, Price, uint64_t)> callback)
+        requires requires(TradeSink& sink) { sink.setOnLevelUpdate(std::function<void(Side, Price, uint64_t)>{}); }
+    {
+        _sink.setOnLevelUpdate(std::move(callback));
     }
 
-    // Find best bid (highest price with orders)
-    inline size_t getBestBidIndex() const noexcept {
-        for (size_t i = _numPriceLevels; i-- > 0;) {
-            if (!_bids[i].empty()) return i;
-        }
-        return SIZE_MAX;
+    // Depth queries on the per-level aggregates (quantity, order count):
+    // they walk occupied levels through the ladder bitmap and never touch
+    // individual orders, so they are cheap enough to run before matching.
+    // A limit of std::nullopt means no price limit (market order).
+
+    // Up to out.size() levels of a side, best first; returns the number written
+    std::size_t depth(Side side, std::span<DepthLevel> out) const;
+    // Resting quantity on a side at prices at least as good as limit
+    // (bids at or above it, asks at or below it)
+    uint64_t cumulativeDepth(Side side, Price limit) const noexcept;
+    // Cost of filling `quantity` for an incoming order on takerSide
+    FillEstimate estimateFill(Side takerSide, uint64_t quantity,
+                              std::optional<Price> limit = std::nullopt) const noexcept;
+    // Fill-or-kill: the whole quantity is available within the limit
+    bool canFillAll(Side takerSide, uint64_t quantity, std::optional<Price> limit = std::nullopt) const noexcept
+    {
+        return estimateFill(takerSide, quantity, limit).quantity == quantity;
+    }
+    // Immediate-or-cancel: the part of quantity that would execute now
+    uint64_t fillableQuantity(Side takerSide, uint64_t quantity, std::optional<Price> limit = std::nullopt) const noexcept
+    {
+        return estimateFill(takerSide, quantity, limit).quantity;
+    }
+
+    // Call auction. In the auction phase limit orders rest without matching
+    // (the book may cross) and market orders are dropped; cancel, reduce
+    // and replace work as usual. uncross() executes every crossing order at
+    // one equilibrium price, in price-time priority, and returns to
+    // continuous matching.
+    void startAuction() noexcept { _phase = TradingPhase::Auction; }
+    TradingPhase phase() const noexcept { return _phase; }
+    // Equilibrium the book would uncross at now, nothing is executed
+    AuctionResult indicativeUncross() const;
+    AuctionResult uncross();
+
+    // While set, trades are appended to out instead of going to the trade
+    // sink, so a batch can hand them on in one call
+    void captureTrades(std::vector<Trade>* out) noexcept { _tradeCapture = out; }
+
+    // Pull the level a limit order would rest on (and its index slot) into
+    // cache ahead of processing it
+    void prefetch(const Order& order) const noexcept
+    {
+        if (order.type != OrderType::Limit)
+            return;
+        (order.side == Side::Buy ? _bids : _asks).prefetch(priceToIndex(order.price));
+        _orders.prefetch(order.id);
+    }
+
+    // visit(order) for every resting order on a side, best level first, FIFO within a level
+    template <typename Visitor>
+    void forEachOrder(Side side, Visitor&& visit) const
+    {
+        const PriceLadder& levels{ side == Side::Buy ? _bids : _asks };
+        for (std::size_t i{ levels.best() }; i != PriceLadder::npos; i = levels.nextAfter(i))
+            for (uint32_t node{ levels.find(i)->head }; node != Storage::npos; node = _orders[node].next)
+                visit(_orders[node].order);
     }
 
-    // Find best ask (lowest price with orders)
-    inline size_t getBestAskIndex() const noexcept {
-        for (size_t i = 0; i < _numPriceLevels; ++i) {
-            if (!_asks[i].empty()) return i;
+    // Binary snapshot of the resting orders (see book_snapshot.hpp). The
+    // book loaded into must be empty and have the same price range and tick;
+    // both throw std::runtime_error on I/O or format errors.
+    void saveSnapshot(const std::string& path, uint64_t inputSequence) const;
+    // Returns the input sequence stored in the snapshot
+    uint64_t loadSnapshot(const std::string& path);
+
+    // visit(price, quantity, orders) for up to maxLevels non-empty levels, best first
+    template <typename Visitor>
+    void forEachLevel(Side side, std::size_t maxLevels, Visitor&& visit) const
+    {
+        const PriceLadder& levels{ side == Side::Buy ? _bids : _asks };
+        for (std::size_t i{ levels.best() }; i != PriceLadder::npos && maxLevels > 0; i = levels.nextAfter(i), --maxLevels)
+        {
+            const PriceLevel* level{ levels.find(i) };
+            visit(indexToPrice(i), level->quantity, level->size());
         }
-        return SIZE_MAX;
     }
-    
-    double _minPrice;
-    double _maxPrice;
-    double _tickSize;
+
+private:
+    inline size_t priceToIndex(Price price) const noexcept {
+        return static_cast<size_t>((price - _minPrice).raw() / _mapping.tick());
+    }
+
+    inline Price indexToPrice(size_t index) const noexcept {
+        return _minPrice + Price::fromRaw(static_cast<int64_t>(index) * _mapping.tick());
+    }
+
+    // Best bid (highest price with orders), cached
+    inline size_t getBestBidIndex() const noexcept { return _bids.best(); }
+
+    // Best ask (lowest price with orders), cached
+    inline size_t getBestAskIndex() const noexcept { return _asks.best(); }
+
+    inline PriceLadder& ladder(Side side) noexcept { return side == Side::Buy ? _bids : _asks; }
+    inline PriceLadder& stopLadder(Side side) noexcept { return side == Side::Buy ? _buyStops : _sellStops; }
+
+    static bool isStop(const Order& order) noexcept
+    {
+        return order.type == OrderType::Stop || order.type == OrderType::StopLimit;
+    }
+
+    inline void emitTrade(const Trade& trade)
+    {
+        _trades.publish(trade);
+        _tradeLow = _hasLastTrade ? std::min(_tradeLow, trade.price) : trade.price;
+        _tradeHigh = _hasLastTrade ? std::max(_tradeHigh, trade.price) : trade.price;
+        _lastTrade = trade.price;
+        _hasLastTrade = true;
+        _fillQty += trade.quantity;
+        addNotional(_fillNotional, trade.price, trade.quantity);
+        if (_tradeCapture)
+            _tradeCapture->push_back(trade);
+        else
+            _sink.onTrade(trade);
+    }
+
+    inline void notifyLevel(Side side, size_t index, uint64_t quantity)
+    {
+        if (_sink.wantsLevelUpdates())
+            _sink.onLevelUpdate(side, indexToPrice(index), quantity);
+    }
+
+    // Cumulative-depth passes over the crossed range; sets index to the
+    // equilibrium level
+    AuctionResult equilibrium(std::size_t& index) const;
+
+    // Continuous matching of one limit or market order
+    void match(Order& order, std::chrono::steady_clock::time_point timestamp);
+
+    // Trigger buckets
+    void armStop(const Order& order);
+    // Head of the first triggered bucket, npos if the trade range triggers nothing
+    uint32_t nextTriggeredStop() noexcept;
+    void fireStops(std::chrono::steady_clock::time_point timestamp);
+
+    // Slide the dense window when the mid leaves its middle half
+    void maybeRecenter();
+
+    // Intrusive FIFO operations on a price level
+    void pushBack(PriceLevel& level, uint32_t node) noexcept;
+    void popFront(Side side, size_t index) noexcept;
+    void unlink(Side side, size_t index, uint32_t node) noexcept;
+    // Detach and free a node; returns the level's remaining quantity
+    uint64_t unlinkNode(PriceLadder& levels, size_t index, uint32_t node) noexcept;
+
+    Price _minPrice;
+    Price _maxPrice;
+    PriceMapping _mapping; // raw price units per tick
     std::size_t _numPriceLevels;
 
-    std::vector<std::deque<std::shared_ptr<Order>>> _bids;
-    std::vector<std::deque<std::shared_ptr<Order>>> _asks;
-    std::vector<Trade> _trades;
+    Storage _orders;
+    PriceLadder _bids;
+    PriceLadder _asks;
+    PriceLadder _buyStops;
+    PriceLadder _sellStops;
+    EventStream<Trade> _trades;
+    std::size_t _maxStopCascade;
+    std::vector<StopActivation> _activations;
+    Price _lastTrade{ 0.0 };
+    // Trade prices not yet fully scanned by fireStops(), see above
+    Price _tradeLow{ 0.0 };
+    Price _tradeHigh{ 0.0 };
+    bool _hasLastTrade{ false };
     Order _lastOrder;
-    std::function<void(const Trade&)> _onTradeCallback;
+    uint64_t _fillQty{ 0 };
+    int64_t _fillNotional{ 0 };
+    std::vector<Trade>* _tradeCapture{ nullptr };
+    TradeSink _sink;
+    TradingPhase _phase{ TradingPhase::Continuous };
+    // Per-level scratch of the auction passes (demand and supply per tick)
+    mutable std::vector<uint64_t> _auctionDemand;
+    mutable std::vector<uint64_t> _auctionSupply;
 };
 
-#endif //ORDER_BOOK_HPP
\ No newline at end of file
+#include "../src/order_book.tpp"
+#include "../src/book_snapshot.tpp"
+#include "../src/auction.tpp"
+#include "../src/depth_queries.tpp"
+
+// The classic book: run-time tick, std::function callbacks, pooled storage
+using OrderBook = BasicOrderBook<CallbackSink, RuntimeTick, PooledStorage>;
+
+// Instantiated once in order_book.cpp
+extern template class BasicOrderBook<CallbackSink, RuntimeTick, PooledStorage>;
+
+#endif //ORDER_BOOK_HPP
@@ -0,0 +1,34 @@
+#ifndef ORDER_FILE_HPP
+#define ORDER_FILE_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include "journal.hpp"
+
+// Read-only memory map of a recorded order flow: a JournalFileHeader and a
+// flat array of JournalRecord, the same layout the engine journal and the
+// generator write. A trailing partial record is ignored.
+class OrderFile
+{
+public:
+    // Throws std::runtime_error if the file cannot be opened or mapped, or
+    // its header does not match this build's record layout
+    explicit OrderFile(const std::string& path);
+    ~OrderFile();
+
+    OrderFile(const OrderFile&) = delete;
+    OrderFile& operator=(const OrderFile&) = delete;
+
+    std::span<const JournalRecord> records() const noexcept
+    {
+        return { reinterpret_cast<const JournalRecord*>(static_cast<const char*>(_data) + sizeof(JournalFileHeader)),
+                 (_bytes - sizeof(JournalFileHeader)) / sizeof(JournalRecord) };
+    }
+
+private:
+    void* _data{ nullptr };
+    std::size_t _bytes{ 0 };
+};
+
+#endif // ORDER_FILE_HPP
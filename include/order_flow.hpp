@@ -0,0 +1,95 @@
+#ifndef ORDER_FLOW_HPP
+#define ORDER_FLOW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "journal.hpp"
+
+enum class SizeDistribution : uint8_t
+{
+    Fixed,     // always meanSize
+    Uniform,   // 1 .. 2 * meanSize - 1
+    Geometric  // many small orders, a long tail of large ones
+};
+
+// Shape of a synthetic order flow. Percentages of the input mix must add
+// up to 100; everything else only changes prices and sizes.
+struct OrderFlowConfig
+{
+    uint64_t seed = 1;
+
+    // Poisson arrivals: exponential gaps between inputs
+    double arrivalRate = 1'000'000.0;  // inputs per second
+
+    // The mid walks one tick up or down as a Poisson process in time
+    double startPrice = 100.0;
+    double tickSize = 0.01;
+    double minPrice = 0.0;             // the walk and all prices stay inside
+    double maxPrice = 10000.0;
+    double tickRate = 10'000.0;        // mid moves per second
+
+    // Input mix, percent of all inputs
+    unsigned limitPercent = 60;
+    unsigned marketPercent = 10;
+    unsigned cancelPercent = 30;
+    // Share of limit orders priced through the mid (they trade on arrival)
+    unsigned aggressivePercent = 10;
+
+    // Passive limits rest 1 + Exp(meanDepthTicks) ticks away from the mid
+    double meanDepthTicks = 8.0;
+
+    SizeDistribution sizeDistribution = SizeDistribution::Geometric;
+    uint64_t meanSize = 10;
+    uint64_t maxSize = 10'000;
+
+    // Cancels pick a random id among the most recent limit orders; older
+    // ones are forgotten so memory stays bounded for any stream length
+    std::size_t cancelWindow = 1 << 16;
+};
+
+// Reproducible synthetic order flow: the same config (seed included) always
+// yields the same stream. No book is simulated, so a cancel may target an
+// order that has already traded; the engine rejects it like a late cancel.
+class OrderFlowGenerator
+{
+public:
+    // Throws std::invalid_argument if the config is inconsistent
+    explicit OrderFlowGenerator(const OrderFlowConfig& config);
+
+    // Next input; its sequence is the position in the stream, starting at 1
+    JournalRecord next() noexcept;
+    // Fill the buffer with the next records
+    void generate(JournalRecord* out, std::size_t count) noexcept;
+
+    // Simulated arrival time of the last input, nanoseconds from the start
+    uint64_t elapsedNanos() const noexcept { return static_cast<uint64_t>(_clock * 1e9); }
+    Price mid() const noexcept { return Price::fromRaw(_midTicks * _tick); }
+
+private:
+    uint64_t random() noexcept;
+    double uniform() noexcept; // (0, 1]
+    double exponential(double mean) noexcept;
+    uint64_t size() noexcept;
+    Price clampTicks(int64_t ticks) const noexcept;
+
+    OrderFlowConfig _config;
+    uint64_t _state[4];
+    int64_t _tick;
+    int64_t _minTicks;
+    int64_t _maxTicks;
+    int64_t _midTicks;
+    double _clock{ 0.0 };
+    double _nextMove{ 0.0 };
+    uint64_t _sequence{ 0 };
+    uint64_t _nextId{ 1 };
+    std::vector<uint64_t> _recent; // ring of recent limit order ids
+    std::size_t _recentCount{ 0 };
+};
+
+// Write `count` records from the generator, after a JournalFileHeader, to
+// a file readable by OrderFile. Throws std::runtime_error on I/O failure.
+void writeOrderFlow(OrderFlowGenerator& generator, uint64_t count, const std::string& path);
+
+#endif // ORDER_FLOW_HPP
@@ -0,0 +1,122 @@
+#ifndef ORDER_INDEX_HPP
+#define ORDER_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing hash from order id to the pool node of the resting order.
+// Linear probing with backward-shift deletion, so there are no tombstones and
+// lookups stay short under a cancel-heavy flow.
+class OrderIndex
+{
+public:
+    static constexpr uint32_t npos{ UINT32_MAX };
+
+    explicit OrderIndex(std::size_t expected = 0) { reserve(expected); }
+
+    // Make room for `expected` keys without rehashing (load factor <= 1/2)
+    void reserve(std::size_t expected)
+    {
+        std::size_t capacity{ 16 };
+        while (capacity < expected * 2)
+            capacity <<= 1;
+        if (capacity > _slots.size())
+            rehash(capacity);
+    }
+
+    uint32_t find(uint64_t id) const noexcept
+    {
+        for (std::size_t i{ hash(id) & _mask };; i = (i + 1) & _mask)
+        {
+            const Slot& slot{ _slots[i] };
+            if (slot.node == npos)
+                return npos;
+            if (slot.id == id)
+                return slot.node;
+        }
+    }
+
+    // Insert or overwrite the mapping for id
+    void insert(uint64_t id, uint32_t node)
+    {
+        if ((_size + 1) * 2 > _slots.size())
+            rehash(_slots.size() * 2);
+
+        for (std::size_t i{ hash(id) & _mask };; i = (i + 1) & _mask)
+        {
+            Slot& slot{ _slots[i] };
+            if (slot.node == npos)
+            {
+                slot = { id, node };
+                ++_size;
+                return;
+            }
+            if (slot.id == id)
+            {
+                slot.node = node;
+                return;
+            }
+        }
+    }
+
+    bool erase(uint64_t id) noexcept
+    {
+        std::size_t i{ hash(id) & _mask };
+        while (_slots[i].id != id || _slots[i].node == npos)
+        {
+            if (_slots[i].node == npos)
+                return false;
+            i = (i + 1) & _mask;
+        }
+
+        // Shift back following entries that would otherwise become unreachable
+        for (std::size_t j{ (i + 1) & _mask }; _slots[j].node != npos; j = (j + 1) & _mask)
+        {
+            std::size_t home{ hash(_slots[j].id) & _mask };
+            if (((j - home) & _mask) >= ((j - i) & _mask))
+            {
+                _slots[i] = _slots[j];
+                i = j;
+            }
+        }
+        _slots[i].node = npos;
+        --_size;
+        return true;
+    }
+
+    // Pull the home slot of id into cache ahead of a bulk insert or lookup
+    void prefetch(uint64_t id) const noexcept { __builtin_prefetch(&_slots[hash(id) & _mask]); }
+
+    std::size_t size() const noexcept { return _size; }
+
+private:
+    struct Slot
+    {
+        uint64_t id{ 0 };
+        uint32_t node{ npos };
+    };
+
+    static std::size_t hash(uint64_t id) noexcept
+    {
+        // Fibonacci hashing spreads sequential ids over the table
+        return static_cast<std::size_t>((id * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Slot> old(capacity);
+        old.swap(_slots);
+        _mask = capacity - 1;
+        _size = 0;
+        for (const Slot& slot : old)
+            if (slot.node != npos)
+                insert(slot.id, slot.node);
+    }
+
+    std::vector<Slot> _slots;
+    std::size_t _mask{ 0 };
+    std::size_t _size{ 0 };
+};
+
+#endif // ORDER_INDEX_HPP
@@ -0,0 +1,88 @@
+#ifndef ORDER_POOL_HPP
+#define ORDER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "order.hpp"
+
+// Resting order with intrusive links to its neighbours in the price level FIFO
+struct OrderNode
+{
+    Order order;
+    uint32_t prev;
+    uint32_t next;
+};
+
+// Head/tail of the intrusive FIFO of one price level, plus the aggregate
+// resting quantity kept up to date on every add, fill, reduce and cancel
+struct PriceLevel
+{
+    uint32_t head{ UINT32_MAX };
+    uint32_t tail{ UINT32_MAX };
+    uint32_t count{ 0 };
+    uint64_t quantity{ 0 };
+
+    bool empty() const noexcept { return count == 0; }
+    std::size_t size() const noexcept { return count; }
+};
+
+// Preallocated slab of order nodes with an intrusive free list.
+// Nodes are addressed by 32-bit index, so growing the slab (only when the
+// preallocated capacity is exhausted) does not invalidate the level links.
+class OrderPool
+{
+public:
+    static constexpr uint32_t npos{ UINT32_MAX };
+
+    explicit OrderPool(std::size_t capacity = 0) { reserve(capacity); }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= _nodes.size())
+            return;
+        std::size_t oldSize{ _nodes.size() };
+        _nodes.resize(capacity);
+        // Thread new nodes onto the free list in index order
+        for (std::size_t i{ capacity }; i-- > oldSize;)
+        {
+            _nodes[i].next = _freeHead;
+            _freeHead = static_cast<uint32_t>(i);
+        }
+    }
+
+    uint32_t allocate(const Order& order)
+    {
+        if (_freeHead == npos)
+            reserve(_nodes.empty() ? 1024 : _nodes.size() * 2);
+
+        uint32_t index{ _freeHead };
+        OrderNode& node{ _nodes[index] };
+        _freeHead = node.next;
+        node.order = order;
+        node.prev = npos;
+        node.next = npos;
+        ++_size;
+        return index;
+    }
+
+    void release(uint32_t index) noexcept
+    {
+        _nodes[index].next = _freeHead;
+        _freeHead = index;
+        --_size;
+    }
+
+    OrderNode& operator[](uint32_t index) noexcept { return _nodes[index]; }
+    const OrderNode& operator[](uint32_t index) const noexcept { return _nodes[index]; }
+
+    std::size_t size() const noexcept { return _size; }
+    std::size_t capacity() const noexcept { return _nodes.size(); }
+
+private:
+    std::vector<OrderNode> _nodes;
+    uint32_t _freeHead{ npos };
+    std::size_t _size{ 0 };
+};
+
+#endif // ORDER_POOL_HPP
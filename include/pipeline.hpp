@@ -0,0 +1,223 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include "journal.hpp"
+#include "latency_histogram.hpp"
+#include "matching_engine.hpp"
+#include "mpscqueue.hpp"
+#include "pre_trade_risk.hpp"
+#include "spscqueue.hpp"
+
+// How a pipeline stage waits when its input queue is empty:
+//   BusySpin  - spin with a pause instruction; lowest latency, burns the core
+//   SpinYield - spin for a while, then yield the CPU between polls
+//   Futex     - spin for a while, then sleep in std::atomic::wait until the
+//               upstream stage rings (its producer then pays a fence and a
+//               load per batch)
+enum class WaitStrategy : uint8_t { BusySpin, SpinYield, Futex };
+
+// busy_spin, spin_yield, futex
+const char* toString(WaitStrategy strategy) noexcept;
+
+// Pin the calling thread to a CPU (Linux; no-op elsewhere). Returns false
+// if the affinity could not be set.
+bool pinCurrentThread(unsigned cpu) noexcept;
+
+// Stage threads, in pipeline order
+enum class PipelineStage : uint8_t { Sequence, Match, Publish };
+
+struct PipelineConfig
+{
+    OrderBookConfig book{};
+    LogMode logMode = LogMode::Off; // the engine's trade log
+    std::array<WaitStrategy, 3> wait{ WaitStrategy::SpinYield, WaitStrategy::SpinYield, WaitStrategy::SpinYield };
+    std::array<int, 3> cpus{ -1, -1, -1 }; // per stage, -1 = not pinned
+    uint32_t spinLimit = 1000;             // empty polls before yielding / sleeping
+};
+
+// One input as it travels through the pipeline
+struct PipelineInput
+{
+    JournalRecord record;
+    AccountId account{ 0 };
+    uint64_t ingressTicks{ 0 }; // TscClock at ingest
+};
+
+// One execution report on its way to the publish stage
+struct PipelineOutput
+{
+    ExecutionReport report;
+    uint64_t ingressTicks;
+};
+
+// Lets a stage sleep on a futex until its producer publishes. ring() is a
+// fence and a load unless the consumer is actually asleep.
+class Doorbell
+{
+public:
+    void enable() noexcept { _enabled = true; }
+
+    void ring() noexcept
+    {
+        if (!_enabled)
+            return;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_sleepers.load(std::memory_order_relaxed) != 0)
+            wakeAll();
+    }
+
+    void wakeAll() noexcept
+    {
+        _value.fetch_add(1, std::memory_order_release);
+        _value.notify_all();
+    }
+
+    // Sleep until rung, unless ready() already holds
+    template <typename Ready>
+    void sleepUnless(Ready&& ready) noexcept
+    {
+        _sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t seen{ _value.load(std::memory_order_acquire) };
+        if (!ready())
+            _value.wait(seen, std::memory_order_acquire);
+        _sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> _value{ 0 };
+    std::atomic<uint32_t> _sleepers{ 0 };
+    bool _enabled{ false };
+};
+
+// Engine report sink of the pipeline: reports go straight into the publish
+// queue, tagged with the ingest time of the input being matched
+class PipelineReportSink
+{
+public:
+    static constexpr std::size_t kQueueSize{ 4096 };
+    using Queue = SPSCQueue<PipelineOutput, kQueueSize>;
+
+    PipelineReportSink(Queue& queue, Doorbell& doorbell) : _queue{ queue }, _doorbell{ doorbell } {}
+
+    void setIngress(uint64_t ticks) noexcept { _ingress = ticks; }
+    void publish(const ExecutionReport& report) noexcept
+    {
+        while (!_queue.push({ report, _ingress }))
+        {
+            _doorbell.ring();
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    Queue& _queue;
+    Doorbell& _doorbell;
+    uint64_t _ingress{ 0 };
+};
+
+using PipelineEngine = BasicMatchingEngine<PipelineReportSink>;
+
+// End-to-end numbers of a run: ingest to publish, per report
+struct PipelineReport
+{
+    uint64_t inputs{ 0 };
+    uint64_t reports{ 0 };
+    double seconds{ 0.0 };
+    HistogramSnapshot latency; // TscClock ticks
+
+    double inputsPerSecond() const noexcept { return seconds > 0.0 ? static_cast<double>(inputs) / seconds : 0.0; }
+};
+
+// Threaded runtime around one matching engine:
+//
+//   ingest (any thread) -> MPSC -> sequence -> SPSC -> match (+ risk) -> SPSC -> publish
+//
+// Ingest threads push inputs stamped with TscClock. The sequence stage
+// merges them into one numbered order, the match stage runs the optional
+// PreTradeRisk inline and the engine (risk follows the book, so it shares
+// the matching thread), and the publish stage hands every report to the
+// callback and records its end-to-end latency. Each stage thread can be
+// pinned and has its own wait strategy; stages drain in batches and ring
+// the next stage once per batch. A full queue makes its producer yield.
+class Pipeline
+{
+public:
+    static constexpr std::size_t kQueueSize{ 4096 };
+    static constexpr std::size_t kBatchSize{ 64 };
+
+    explicit Pipeline(const PipelineConfig& config = {});
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Before start(): risk in front of matching, limits set on the result
+    PreTradeRisk& enableRisk(std::size_t accounts, std::size_t expectedOrders = 1 << 16);
+    // Before start(): called on the publish thread for every report
+    void setOnReport(std::function<void(const ExecutionReport&)> callback) { _onReport = std::move(callback); }
+
+    void start();
+    // Drain every stage in order and join the threads
+    void stop();
+
+    // Ingest, from any thread. push() is non-blocking (false if the ingest
+    // queue is full), the others yield until there is room.
+    bool push(const JournalRecord& record, AccountId account = 0);
+    void submit(const Order& order);
+    void cancel(uint64_t id);
+
+    PipelineReport report() const;
+    void printReport(std::ostream& os) const;
+
+    // Only safe to inspect while the pipeline is stopped
+    const PipelineEngine& engine() const noexcept { return *_engine; }
+    const PreTradeRisk* risk() const noexcept { return _risk.get(); }
+
+private:
+    // Poll until the upstream stage is done and the input is drained
+    template <typename Poll, typename HasInput>
+    void runStage(PipelineStage stage, Doorbell& doorbell, const std::atomic<bool>& upstreamDone,
+                  Poll&& poll, HasInput&& hasInput);
+
+    void sequenceLoop();
+    void matchLoop();
+    void publishLoop();
+    void dispatch(const PipelineInput& input);
+
+    PipelineConfig _config;
+
+    MPSCQueue<PipelineInput, kQueueSize> _ingest;
+    Doorbell _ingestBell;
+    SPSCQueue<PipelineInput, kQueueSize> _sequenced;
+    Doorbell _sequencedBell;
+    PipelineReportSink::Queue _published;
+    Doorbell _publishedBell;
+
+    std::unique_ptr<PipelineEngine> _engine;
+    std::unique_ptr<PreTradeRisk> _risk;
+    std::function<void(const ExecutionReport&)> _onReport;
+
+    std::atomic<bool> _running{ false };
+    std::atomic<bool> _stopping{ false };
+    std::atomic<bool> _sequenceDone{ false };
+    std::atomic<bool> _matchDone{ false };
+    std::array<std::thread, 3> _threads;
+
+    // Written by the stage threads, read by report()
+    std::atomic<uint64_t> _inputs{ 0 };
+    std::atomic<uint64_t> _reports{ 0 };
+    LatencyHistogram _latency;
+    std::chrono::steady_clock::time_point _startTime{};
+    std::chrono::steady_clock::time_point _stopTime{};
+};
+
+#endif // PIPELINE_HPP
@@ -0,0 +1,203 @@
+#ifndef PRE_TRADE_RISK_HPP
+#define PRE_TRADE_RISK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "order.hpp"
+#include "order_index.hpp"
+#include "trade.hpp"
+#include "tsc_clock.hpp"
+
+// Per-account limits. Decimal values are converted to raw units once, in
+// PreTradeRisk::setLimits; 0 disables a check.
+struct RiskLimits
+{
+    uint64_t maxOrderQty = 0;
+    // How far a limit price may go through the opposite best (buy above
+    // the best ask, sell below the best bid). Market orders are sized at
+    // the opposite best plus the collar for the notional check.
+    double priceCollar = 0.0;
+    // Position plus the resting quantity on the side of the order, in
+    // either direction
+    uint64_t maxPosition = 0;
+    // Price * quantity of resting orders plus the new order
+    double maxNotional = 0.0;
+    // Sustained messages per second and how many may arrive back to back
+    uint32_t maxMessagesPerSecond = 0;
+    uint32_t burst = 1;
+};
+
+enum class RiskReject : uint8_t
+{
+    None,
+    UnknownAccount,
+    Throttled,
+    OrderSize,
+    PriceCollar,
+    Position,
+    Notional
+};
+
+// none, unknown_account, throttled, order_size, price_collar, position, notional
+const char* toString(RiskReject reason) noexcept;
+
+// Exposure of one account as seen by the risk stage
+struct AccountExposure
+{
+    int64_t position{ 0 };     // filled buys minus filled sells
+    uint64_t openBuy{ 0 };     // resting buy quantity
+    uint64_t openSell{ 0 };    // resting sell quantity
+    int64_t openNotional{ 0 }; // sum of price.raw() * quantity of resting orders, saturating
+    uint64_t nextAllowed{ 0 }; // throttle: theoretical arrival time, TscClock ticks
+};
+
+// Inline pre-trade risk, run on the matching thread right before the
+// engine: no locks, no allocation on the order path, and per-account
+// limits and exposure in flat arrays indexed by Order::account (ids are
+// dense, 0..accounts-1). check() reads the account's two entries and the
+// book's cached best prices.
+//
+// Exposure follows the book: submit/cancel/reduce/replace forward to the
+// engine and then account for what happened - fills move positions (for
+// the aggressor and every resting order entered through this stage) and
+// the part left resting is held as open quantity and notional until it
+// fills or is canceled. Fills are read from the book's trade stream, so
+// trades that fall out of its retention between two calls are missed.
+//
+// The throttle is a generic cell rate algorithm on TscClock ticks: one
+// timestamp per account. Every new order and replacement counts, accepted
+// or not; cancels and reductions only lower exposure and always pass.
+class PreTradeRisk
+{
+public:
+    explicit PreTradeRisk(std::size_t accounts, std::size_t expectedOrders = 1 << 16);
+
+    void setLimits(AccountId account, const RiskLimits& limits);
+    const AccountExposure& exposure(AccountId account) const noexcept { return _exposure[account]; }
+    std::size_t accounts() const noexcept { return _limits.size(); }
+    // Messages rejected per reason (index: RiskReject)
+    uint64_t rejected(RiskReject reason) const noexcept { return _rejected[static_cast<std::size_t>(reason)]; }
+
+    // The pre-trade check alone: it only updates the throttle state. A
+    // null best price means that side of the book is empty.
+    RiskReject check(const Order& order, std::optional<Price> bestBid, std::optional<Price> bestAsk,
+                     uint64_t now = TscClock::now()) noexcept;
+
+    // Check, then hand the order to engine.processOrder or, if refused, to
+    // engine.rejectOrder. Returns the reject reason (None = accepted).
+    template <typename Engine>
+    RiskReject submit(Engine& engine, const Order& order)
+    {
+        const auto& book{ engine.getOrderBook() };
+        RiskReject reason{ check(order, book.bestBid(), book.bestAsk()) };
+        if (reason != RiskReject::None)
+        {
+            engine.rejectOrder(order);
+            return reason;
+        }
+        engine.processOrder(order);
+        afterOrder(book, order);
+        return reason;
+    }
+
+    template <typename Engine>
+    void cancel(Engine& engine, uint64_t id)
+    {
+        engine.cancelOrder(id);
+        if (!engine.getOrderBook().findOrder(id))
+            release(id, 0);
+    }
+
+    template <typename Engine>
+    void reduce(Engine& engine, uint64_t id, uint64_t newQuantity)
+    {
+        engine.reduceOrder(id, newQuantity);
+        const Order* resting{ engine.getOrderBook().findOrder(id) };
+        release(id, resting ? resting->quantity : 0);
+    }
+
+    // The replacement is checked like a new order with the old one's
+    // exposure still counted (conservative); refused by risk or by the
+    // engine = old order and its exposure untouched
+    template <typename Engine>
+    RiskReject replace(Engine& engine, uint64_t id, const Order& replacement)
+    {
+        const auto& book{ engine.getOrderBook() };
+        RiskReject reason{ check(replacement, book.bestBid(), book.bestAsk()) };
+        if (reason != RiskReject::None)
+        {
+            engine.rejectOrder(replacement);
+            return reason;
+        }
+        if (engine.replaceOrder(id, replacement))
+        {
+            release(id, 0);
+            afterOrder(book, replacement);
+        }
+        return reason;
+    }
+
+    // Account for trades the book produced outside submit (e.g. an
+    // auction uncross)
+    template <typename Book>
+    void syncTrades(const Book& book)
+    {
+        book.getTrades().poll(_tradeCursor, [this](uint64_t, const Trade& trade) { onTrade(trade, nullptr); });
+        for (const auto& activation : book.lastActivations())
+            release(activation.id, activation.leavesQty);
+    }
+
+private:
+    // Raw-unit copy of RiskLimits, 0 = off
+    struct Limits
+    {
+        uint64_t maxOrderQty{ 0 };
+        int64_t collar{ 0 };
+        uint64_t maxPosition{ 0 };
+        int64_t maxNotional{ 0 };
+        uint64_t emissionTicks{ 0 }; // ticks per message
+        uint64_t burstTicks{ 0 };    // tolerated run ahead of the sustained rate
+    };
+
+    // A resting order entered through this stage
+    struct Resting
+    {
+        AccountId account;
+        Side side;
+        int64_t price;
+        uint64_t quantity;
+    };
+
+    template <typename Book>
+    void afterOrder(const Book& book, const Order& order)
+    {
+        book.getTrades().poll(_tradeCursor, [&](uint64_t, const Trade& trade) { onTrade(trade, &order); });
+        if (const Order* resting = book.findOrder(order.id); resting && order.type != OrderType::Market)
+            rest(order, resting->quantity);
+        // Triggered stops keep only what now rests as a limit order
+        for (const auto& activation : book.lastActivations())
+            release(activation.id, activation.leavesQty);
+    }
+
+    // Position update for both sides of a trade; aggressor is the order
+    // being submitted (not resting yet), nullptr if none
+    void onTrade(const Trade& trade, const Order* aggressor) noexcept;
+    void fill(uint64_t id, Side side, uint64_t quantity, const Order* aggressor) noexcept;
+    void rest(const Order& order, uint64_t quantity);
+    // Keep `remaining` of a resting order's exposure (0 forgets the order)
+    void release(uint64_t id, uint64_t remaining) noexcept;
+
+    std::vector<Limits> _limits;
+    std::vector<AccountExposure> _exposure;
+    std::array<uint64_t, 7> _rejected{};
+
+    OrderIndex _index; // order id -> slot in _resting
+    std::vector<Resting> _resting;
+    std::vector<uint32_t> _freeSlots;
+    uint64_t _tradeCursor{ 0 };
+};
+
+#endif // PRE_TRADE_RISK_HPP
@@ -0,0 +1,71 @@
+#ifndef PRICE_HPP
+#define PRICE_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+
+// Fixed-point price: an integer number of 1/kScale units.
+// Decimal values are converted only at the edges (construction from double,
+// printing); everything inside the book compares and indexes raw integers.
+class Price
+{
+public:
+    static constexpr int64_t kScale{ 1'000'000 };
+
+    constexpr Price() = default;
+
+    // Implicit on purpose: order entry and tests speak in decimal prices
+    constexpr Price(double value)
+        : _raw{ static_cast<int64_t>(value * kScale + (value < 0 ? -0.5 : 0.5)) }
+    {
+    }
+
+    static constexpr Price fromRaw(int64_t raw) noexcept
+    {
+        Price price;
+        price._raw = raw;
+        return price;
+    }
+
+    constexpr int64_t raw() const noexcept { return _raw; }
+    constexpr double toDouble() const noexcept { return static_cast<double>(_raw) / kScale; }
+
+    friend constexpr bool operator==(const Price&, const Price&) = default;
+    friend constexpr auto operator<=>(const Price&, const Price&) = default;
+
+    friend constexpr Price operator+(Price a, Price b) noexcept { return fromRaw(a._raw + b._raw); }
+    friend constexpr Price operator-(Price a, Price b) noexcept { return fromRaw(a._raw - b._raw); }
+
+    friend std::ostream& operator<<(std::ostream& os, Price price) { return os << price.toDouble(); }
+
+private:
+    int64_t _raw{ 0 };
+};
+
+// Add price.raw() * quantity to a notional in raw units. On overflow the
+// total saturates at the int64 limit (in the direction of the price) and
+// false is returned; a saturated total stays saturated.
+inline bool addNotional(int64_t& total, Price price, uint64_t quantity) noexcept
+{
+    int64_t product;
+    if (!__builtin_mul_overflow(price.raw(), quantity, &product) && !__builtin_add_overflow(total, product, &total))
+        return true;
+    total = price.raw() < 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+    return false;
+}
+
+// notional / quantity rounded half up, without overflow for any notional
+// (a saturated one included); 0 for quantity 0
+inline Price averagePrice(int64_t notional, uint64_t quantity) noexcept
+{
+    if (quantity == 0)
+        return Price{};
+    auto divisor{ static_cast<int64_t>(std::min<uint64_t>(quantity, std::numeric_limits<int64_t>::max())) };
+    int64_t rest{ notional % divisor };
+    return Price::fromRaw(notional / divisor + (rest >= divisor - divisor / 2 ? 1 : 0));
+}
+
+#endif // PRICE_HPP
@@ -0,0 +1,135 @@
+#ifndef PRICE_BITMAP_HPP
+#define PRICE_BITMAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical occupancy bitmap over price levels.
+// Level 0 has one bit per price level, every upper level has one bit per
+// non-zero word of the level below. With 64-bit words a million levels need
+// four levels, so any search touches at most a handful of words.
+class PriceBitmap
+{
+public:
+    static constexpr std::size_t npos{ SIZE_MAX };
+
+    explicit PriceBitmap(std::size_t size = 0) { resize(size); }
+
+    void resize(std::size_t size)
+    {
+        _size = size;
+        _levels.clear();
+        std::size_t bits{ size };
+        do
+        {
+            std::size_t words{ (bits + 63) / 64 };
+            _levels.emplace_back(words == 0 ? 1 : words, 0);
+            bits = words;
+        } while (bits > 1);
+    }
+
+    std::size_t size() const noexcept { return _size; }
+
+    bool test(std::size_t i) const noexcept
+    {
+        return (_levels[0][i >> 6] >> (i & 63)) & 1;
+    }
+
+    bool empty() const noexcept { return _levels.back()[0] == 0; }
+
+    void set(std::size_t i) noexcept
+    {
+        for (auto& level : _levels)
+        {
+            uint64_t& word{ level[i >> 6] };
+            bool wasEmpty{ word == 0 };
+            word |= uint64_t{ 1 } << (i & 63);
+            if (!wasEmpty)
+                return;
+            i >>= 6;
+        }
+    }
+
+    void clear(std::size_t i) noexcept
+    {
+        for (auto& level : _levels)
+        {
+            uint64_t& word{ level[i >> 6] };
+            word &= ~(uint64_t{ 1 } << (i & 63));
+            if (word != 0)
+                return;
+            i >>= 6;
+        }
+    }
+
+    // First set bit with index >= from
+    std::size_t findNext(std::size_t from) const noexcept
+    {
+        if (from >= _size)
+            return npos;
+
+        std::size_t level{ 0 };
+        std::size_t idx{ from };
+        while (true)
+        {
+            std::size_t word{ idx >> 6 };
+            uint64_t bits{ _levels[level][word] & (~uint64_t{ 0 } << (idx & 63)) };
+            if (bits)
+            {
+                idx = (word << 6) + static_cast<std::size_t>(std::countr_zero(bits));
+                break;
+            }
+            if (level + 1 == _levels.size())
+                return npos;
+            ++level;
+            idx = word + 1;
+            if ((idx >> 6) >= _levels[level].size())
+                return npos;
+        }
+
+        while (level-- > 0)
+            idx = (idx << 6) + static_cast<std::size_t>(std::countr_zero(_levels[level][idx]));
+        return idx;
+    }
+
+    // Last set bit with index <= from
+    std::size_t findPrev(std::size_t from) const noexcept
+    {
+        if (_size == 0)
+            return npos;
+        if (from >= _size)
+            from = _size - 1;
+
+        std::size_t level{ 0 };
+        std::size_t idx{ from };
+        while (true)
+        {
+            std::size_t word{ idx >> 6 };
+            uint64_t bits{ _levels[level][word] & (~uint64_t{ 0 } >> (63 - (idx & 63))) };
+            if (bits)
+            {
+                idx = (word << 6) + 63 - static_cast<std::size_t>(std::countl_zero(bits));
+                break;
+            }
+            if (level + 1 == _levels.size() || word == 0)
+                return npos;
+            ++level;
+            idx = word - 1;
+        }
+
+        while (level-- > 0)
+            idx = (idx << 6) + 63 - static_cast<std::size_t>(std::countl_zero(_levels[level][idx]));
+        return idx;
+    }
+
+    std::size_t findFirst() const noexcept { return findNext(0); }
+    std::size_t findLast() const noexcept { return findPrev(npos); }
+
+private:
+    std::size_t _size{ 0 };
+    std::vector<std::vector<uint64_t>> _levels;
+};
+
+#endif // PRICE_BITMAP_HPP
@@ -0,0 +1,83 @@
+#ifndef PRICE_LADDER_HPP
+#define PRICE_LADDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "order.hpp"
+#include "order_pool.hpp"
+#include "price_bitmap.hpp"
+
+// One side of the book, addressed by absolute tick index.
+// Levels inside [base, base + windowSize) live in a dense array with an
+// occupancy bitmap; levels outside the window go to a sparse overflow map.
+// A ladder whose window covers the whole price range is the plain dense book.
+class PriceLadder
+{
+public:
+    static constexpr std::size_t npos{ SIZE_MAX };
+
+    PriceLadder(Side side, std::size_t numLevels, std::size_t windowSize);
+
+    // Level at index, created in the overflow map if outside the window
+    inline PriceLevel& level(std::size_t index)
+    {
+        if (index - _base < _windowSize)
+            return _window[index - _base];
+        return _overflow[index];
+    }
+
+    inline const PriceLevel* find(std::size_t index) const noexcept
+    {
+        if (index - _base < _windowSize)
+            return &_window[index - _base];
+        auto it{ _overflow.find(index) };
+        return it == _overflow.end() ? nullptr : &it->second;
+    }
+
+    // Hint only: levels outside the window are not touched
+    inline void prefetch(std::size_t index) const noexcept
+    {
+        if (index - _base < _windowSize)
+            __builtin_prefetch(&_window[index - _base]);
+    }
+
+    // out[k] = resting quantity at level from + k, for k < count
+    void copyQuantities(std::size_t from, std::size_t count, uint64_t* out) const;
+
+    // Must be called when a level goes from empty to non-empty and back
+    void onFilled(std::size_t index) noexcept;
+    void onEmptied(std::size_t index) noexcept;
+
+    // Best level (highest bid / lowest ask), npos if the side is empty
+    inline std::size_t best() const noexcept { return _best; }
+    // Next non-empty level strictly worse than index, npos if none
+    std::size_t nextAfter(std::size_t index) const noexcept;
+
+    // Move the window to start at base, migrating levels to/from overflow
+    void recenter(std::size_t base);
+
+    std::size_t base() const noexcept { return _base; }
+    std::size_t windowSize() const noexcept { return _windowSize; }
+    std::size_t overflowLevels() const noexcept { return _overflow.size(); }
+
+private:
+    bool isBetter(std::size_t a, std::size_t b) const noexcept
+    {
+        return _side == Side::Buy ? a > b : a < b;
+    }
+
+    Side _side;
+    std::size_t _numLevels;
+    std::size_t _windowSize;
+    std::size_t _base{ 0 };
+    std::size_t _best{ npos };
+
+    std::vector<PriceLevel> _window;
+    std::vector<PriceLevel> _scratch; // spare window buffer for recenter()
+    PriceBitmap _occupied;
+    std::map<std::size_t, PriceLevel> _overflow;
+};
+
+#endif // PRICE_LADDER_HPP
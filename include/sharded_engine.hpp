@@ -0,0 +1,88 @@
+#ifndef SHARDED_ENGINE_HPP
+#define SHARDED_ENGINE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "order_book.hpp"
+#include "spscqueue.hpp"
+
+// Multi-instrument engine: books are partitioned across N matching threads,
+// each fed by its own SPSC queue. The thread calling route()/submit() is the
+// router and the single producer of every shard queue. Each shard checks
+// orders with OrderBook::acceptsOrder before matching and counts the ones
+// its book refuses instead of processing them.
+class ShardedEngine
+{
+public:
+    static constexpr std::size_t kQueueSize{ 4096 };
+    static constexpr std::size_t kBatchSize{ 64 };
+
+    explicit ShardedEngine(std::size_t numShards, bool pinThreads = true);
+    ~ShardedEngine();
+
+    ShardedEngine(const ShardedEngine&) = delete;
+    ShardedEngine& operator=(const ShardedEngine&) = delete;
+
+    // Register a symbol before start(); instruments are dealt round-robin to shards
+    InstrumentId addInstrument(const std::string& symbol,
+                               const OrderBookConfig& config = OrderBookConfig{ .orderCapacity = 1 << 12,
+                                                                                .windowLevels = 4096,
+                                                                                .tradeRetention = 1 << 12 });
+    // Instrument id of a registered symbol, throws std::out_of_range if unknown
+    InstrumentId instrumentId(const std::string& symbol) const { return _symbols.at(symbol); }
+
+    void start();
+    // Drain every shard queue and join the matching threads
+    void stop();
+
+    // Non-blocking dispatch, false if the shard queue is full
+    bool route(const Order& order);
+    // Dispatch, spinning while the shard queue is full
+    void submit(const Order& order);
+
+    std::size_t numShards() const noexcept { return _shards.size(); }
+    std::size_t shardOf(InstrumentId instrument) const noexcept { return _placement[instrument].shard; }
+    uint64_t processedOrders() const noexcept;
+    uint64_t executedTrades() const noexcept;
+    // Orders refused by acceptsOrder, in total and for one shard
+    uint64_t rejectedOrders() const noexcept;
+    uint64_t rejectedOrders(std::size_t shard) const noexcept
+    {
+        return _shards[shard]->rejected.load(std::memory_order_relaxed);
+    }
+
+    // Only safe to inspect while the engine is stopped
+    const OrderBook& getOrderBook(InstrumentId instrument) const;
+
+private:
+    struct Shard
+    {
+        SPSCQueue<Order, kQueueSize> queue;
+        std::vector<std::unique_ptr<OrderBook>> books; // indexed by Placement::slot
+        std::thread thread;
+        std::atomic<uint64_t> processed{ 0 };
+        std::atomic<uint64_t> trades{ 0 };
+        std::atomic<uint64_t> rejected{ 0 };
+    };
+
+    struct Placement
+    {
+        uint32_t shard;
+        uint32_t slot;
+    };
+
+    void run(std::size_t shardIndex);
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::vector<Placement> _placement; // indexed by InstrumentId
+    std::unordered_map<std::string, InstrumentId> _symbols;
+    std::atomic<bool> _running{ false };
+    bool _pinThreads;
+};
+
+#endif // SHARDED_ENGINE_HPP
@@ -4,23 +4,55 @@
 #include <atomic>
 #include <cstddef>
 #include <array>
+#include <span>
 #include <vector>
 
+// Bounded lock-free single-producer/single-consumer ring.
+// Indices grow monotonically and are masked into the buffer, so all N slots
+// are usable. Producer and consumer state live on separate cache lines and
+// each side caches the other side's index, touching the shared atomic only
+// when the cached value says the ring looks full (or empty).
 template <typename T, std::size_t N>
 class SPSCQueue
-{ 
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
 public:
+    static constexpr std::size_t kCapacity{ N };
+
     SPSCQueue() = default;
     bool pop(T& item);
     bool push(const T& item);
     std::size_t popBatch(std::vector<T>& out, std::size_t maxSize);
 
-private:    
-    std::atomic<std::size_t> _head{};
-    std::atomic<std::size_t> _tail{};
-    std::array<T, N> _buffer{};
+    // Zero-copy batches: claim a contiguous run of slots, use it in place,
+    // then commit how many were actually consumed/produced. A claim never
+    // wraps, so it may return fewer slots than are available.
+    std::span<T> claimRead(std::size_t maxSize);
+    void commitRead(std::size_t count);
+    std::span<T> claimWrite(std::size_t maxSize);
+    void commitWrite(std::size_t count);
+
+    std::size_t size() const noexcept
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr std::size_t kMask{ N - 1 };
+    static constexpr std::size_t kCacheLine{ 64 };
+
+    // Producer line
+    alignas(kCacheLine) std::atomic<std::size_t> _head{};
+    std::size_t _cachedTail{};
+    // Consumer line
+    alignas(kCacheLine) std::atomic<std::size_t> _tail{};
+    std::size_t _cachedHead{};
+
+    alignas(kCacheLine) std::array<T, N> _buffer{};
 };
 
 #include "../src/spscqueue.tpp"
 
-#endif // SPSCQUEUE_HPP
\ No newline at end of file
+#endif // SPSCQUEUE_HPP
@@ -3,14 +3,17 @@
 
 #include <stdint.h>
 #include <chrono>
+#include "price.hpp"
+#include "order.hpp"
 
 struct Trade
 {
     uint64_t buy_id;
     uint64_t sell_id;
-    double price;
+    Price price;
     uint64_t quantity;
     std::chrono::steady_clock::time_point timestamp;
+    InstrumentId instrument{ 0 };
 };
 
 #endif //TRADE_HPP
\ No newline at end of file
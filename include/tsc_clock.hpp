@@ -0,0 +1,52 @@
+#ifndef TSC_CLOCK_HPP
+#define TSC_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Cheap timestamp source for latency measurement. Reads the invariant TSC
+// on x86 (no syscall, no vDSO) and falls back to steady_clock elsewhere.
+// Ticks are converted to nanoseconds only when results are reported.
+class TscClock
+{
+public:
+    static inline uint64_t now() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Nanoseconds per tick, calibrated once against steady_clock
+    static double nanosPerTick()
+    {
+        static const double ratio{ calibrate() };
+        return ratio;
+    }
+
+    static double toNanos(uint64_t ticks) { return static_cast<double>(ticks) * nanosPerTick(); }
+
+private:
+    static double calibrate()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        auto wallStart{ std::chrono::steady_clock::now() };
+        uint64_t tscStart{ now() };
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t tscEnd{ now() };
+        auto wallEnd{ std::chrono::steady_clock::now() };
+        double nanos{ std::chrono::duration<double, std::nano>(wallEnd - wallStart).count() };
+        return nanos / static_cast<double>(tscEnd - tscStart);
+#else
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::duration{ 1 }).count();
+#endif
+    }
+};
+
+#endif // TSC_CLOCK_HPP
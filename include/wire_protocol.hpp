@@ -0,0 +1,345 @@
+#ifndef WIRE_PROTOCOL_HPP
+#define WIRE_PROTOCOL_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include "journal.hpp"
+#include "matching_engine.hpp"
+#include "order.hpp"
+
+// Fixed-layout binary order-entry protocol, little-endian on the wire.
+// Every frame is an 8-byte header followed by a fixed-size body:
+//
+//   offset  header                    NewOrder body (48)      ExecutionReport body (56)
+//   0       u16 length (whole frame)  u64 id                  u64 id
+//   2       u16 type (WireType)       i64 price (raw)         i64 price (raw)
+//   4       u16 schema version        i64 stop price (raw)    u64 quantity
+//   6       u16 reserved (0)          u64 quantity            u64 filled quantity
+//   8+24                              u32 instrument          u64 leaves quantity
+//   8+28                              u32 account             i64 avg fill price (raw)
+//   8+32                              u8 side, u8 type, 6 pad u8 status, 7 pad
+//
+// Cancel: u64 id. Replace: u64 id of the order replaced, then a NewOrder
+// body. Prices are Price::raw() values. Decoding is in place: a view reads
+// each field straight from the receive buffer at a fixed offset (one load,
+// plus a byte swap on big-endian hosts) and nothing is allocated or parsed
+// field by field. Frames are validated once, in peekFrame(), before any
+// view is handed out. The codec checks structure only; whether a price is
+// on the book's grid and the quantity positive is checked where the order
+// enters the engine (OrderBook::acceptsOrder), which answers Rejected.
+
+enum class WireType : uint16_t { NewOrder = 1, Cancel = 2, Replace = 3, ExecutionReport = 4 };
+
+enum class WireError : uint8_t
+{
+    None,
+    Incomplete,  // the buffer ends inside the frame, wait for more bytes
+    BadLength,   // length field does not match the message type
+    UnknownType,
+    BadVersion,
+    BadField     // side, order type or status out of range, reserved bytes set
+};
+
+// none, incomplete, bad_length, unknown_type, bad_version, bad_field
+const char* toString(WireError error) noexcept;
+
+namespace wire_detail
+{
+template <typename T>
+constexpr T byteSwap(T value) noexcept
+{
+    T result{ 0 };
+    for (std::size_t i{ 0 }; i < sizeof(T); ++i)
+    {
+        result = static_cast<T>((result << 8) | (value & 0xFF));
+        value = static_cast<T>(value >> 8);
+    }
+    return result;
+}
+
+template <typename T>
+inline T load(const std::byte* at) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    U value;
+    std::memcpy(&value, at, sizeof(value));
+    if constexpr (std::endian::native == std::endian::big)
+        value = byteSwap(value);
+    return static_cast<T>(value);
+}
+
+template <typename T>
+inline void store(std::byte* at, T value) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    auto raw{ static_cast<U>(value) };
+    if constexpr (std::endian::native == std::endian::big)
+        raw = byteSwap(raw);
+    std::memcpy(at, &raw, sizeof(raw));
+}
+} // namespace wire_detail
+
+struct WireLayout
+{
+    static constexpr uint16_t kSchemaVersion{ 1 };
+    static constexpr std::size_t kHeaderSize{ 8 };
+    static constexpr std::size_t kOrderBodySize{ 48 };
+    static constexpr std::size_t kNewOrderSize{ kHeaderSize + kOrderBodySize };
+    static constexpr std::size_t kCancelSize{ kHeaderSize + 8 };
+    static constexpr std::size_t kReplaceSize{ kHeaderSize + 8 + kOrderBodySize };
+    static constexpr std::size_t kExecutionReportSize{ kHeaderSize + 56 };
+    static constexpr std::size_t kMaxFrameSize{ kExecutionReportSize };
+
+    // Frame size of a type, 0 if unknown
+    static constexpr std::size_t frameSize(uint16_t type) noexcept
+    {
+        switch (static_cast<WireType>(type))
+        {
+            case WireType::NewOrder:        return kNewOrderSize;
+            case WireType::Cancel:          return kCancelSize;
+            case WireType::Replace:         return kReplaceSize;
+            case WireType::ExecutionReport: return kExecutionReportSize;
+        }
+        return 0;
+    }
+};
+
+// Order fields of a NewOrder or Replace body starting at `body`
+class WireOrderFields
+{
+public:
+    explicit WireOrderFields(const std::byte* body) noexcept : _body{ body } {}
+
+    uint64_t id() const noexcept { return wire_detail::load<uint64_t>(_body); }
+    Price price() const noexcept { return Price::fromRaw(wire_detail::load<int64_t>(_body + 8)); }
+    Price stopPrice() const noexcept { return Price::fromRaw(wire_detail::load<int64_t>(_body + 16)); }
+    uint64_t quantity() const noexcept { return wire_detail::load<uint64_t>(_body + 24); }
+    InstrumentId instrument() const noexcept { return wire_detail::load<uint32_t>(_body + 32); }
+    AccountId account() const noexcept { return wire_detail::load<uint32_t>(_body + 36); }
+    Side side() const noexcept { return static_cast<Side>(std::to_integer<uint8_t>(_body[40])); }
+    OrderType type() const noexcept { return static_cast<OrderType>(std::to_integer<uint8_t>(_body[41])); }
+
+    // The engine order; timestamp stays unset, the engine stamps trades itself
+    Order toOrder() const noexcept
+    {
+        Order order;
+        order.id = id();
+        order.side = side();
+        order.type = type();
+        order.price = price();
+        order.quantity = quantity();
+        order.instrument = instrument();
+        order.account = account();
+        order.stopPrice = stopPrice();
+        return order;
+    }
+
+    static void encode(std::byte* body, const Order& order) noexcept
+    {
+        wire_detail::store<uint64_t>(body, order.id);
+        wire_detail::store<int64_t>(body + 8, order.price.raw());
+        wire_detail::store<int64_t>(body + 16, order.stopPrice.raw());
+        wire_detail::store<uint64_t>(body + 24, order.quantity);
+        wire_detail::store<uint32_t>(body + 32, order.instrument);
+        wire_detail::store<uint32_t>(body + 36, order.account);
+        body[40] = static_cast<std::byte>(order.side);
+        body[41] = static_cast<std::byte>(order.type);
+        std::memset(body + 42, 0, 6);
+    }
+
+    // Enumerations in range and padding zero
+    static bool valid(const std::byte* body) noexcept
+    {
+        uint64_t padding{ wire_detail::load<uint64_t>(body + 40) >> 16 };
+        return std::to_integer<uint8_t>(body[40]) <= static_cast<uint8_t>(Side::Sell)
+            && std::to_integer<uint8_t>(body[41]) <= static_cast<uint8_t>(OrderType::StopLimit) && padding == 0;
+    }
+
+private:
+    const std::byte* _body;
+};
+
+// A validated frame at the front of a buffer
+class WireFrame
+{
+public:
+    WireFrame() = default;
+    WireFrame(const std::byte* data, WireType type) noexcept : _data{ data }, _type{ type } {}
+
+    WireType type() const noexcept { return _type; }
+    std::size_t size() const noexcept { return WireLayout::frameSize(static_cast<uint16_t>(_type)); }
+
+    // NewOrder
+    WireOrderFields newOrder() const noexcept { return WireOrderFields{ _data + WireLayout::kHeaderSize }; }
+    // Cancel and Replace: the order the message refers to
+    uint64_t targetId() const noexcept { return wire_detail::load<uint64_t>(_data + WireLayout::kHeaderSize); }
+    // Replace
+    WireOrderFields replacement() const noexcept { return WireOrderFields{ _data + WireLayout::kHeaderSize + 8 }; }
+    // NewOrder, Cancel and Replace as the engine's input record (sequence 0,
+    // the sequencer numbers it) and the account the order is entered for
+    JournalRecord record() const noexcept
+    {
+        switch (_type)
+        {
+            case WireType::NewOrder: return JournalRecord::fromOrder(0, JournalKind::New, newOrder().toOrder());
+            case WireType::Replace:
+                return JournalRecord::fromOrder(0, JournalKind::Replace, replacement().toOrder(), targetId());
+            default:                 return { 0, JournalKind::Cancel, 0, 0, 0, 0, 0, targetId(), 0, 0 };
+        }
+    }
+    AccountId account() const noexcept
+    {
+        switch (_type)
+        {
+            case WireType::NewOrder: return newOrder().account();
+            case WireType::Replace:  return replacement().account();
+            default:                 return 0;
+        }
+    }
+    // ExecutionReport
+    ExecutionReport executionReport() const noexcept
+    {
+        const std::byte* body{ _data + WireLayout::kHeaderSize };
+        ExecutionReport report{ wire_detail::load<uint64_t>(body),
+                                static_cast<ExecStatus>(std::to_integer<uint8_t>(body[48])),
+                                Price::fromRaw(wire_detail::load<int64_t>(body + 8)),
+                                wire_detail::load<uint64_t>(body + 16) };
+        report.filledQty = wire_detail::load<uint64_t>(body + 24);
+        report.leavesQty = wire_detail::load<uint64_t>(body + 32);
+        report.avgFillPrice = Price::fromRaw(wire_detail::load<int64_t>(body + 40));
+        return report;
+    }
+
+private:
+    const std::byte* _data{ nullptr };
+    WireType _type{ WireType::NewOrder };
+};
+
+// Validate the frame at the front of buffer. On None, frame views it and
+// its size() bytes may be consumed; nothing is read past the buffer.
+inline WireError peekFrame(std::span<const std::byte> buffer, WireFrame& frame) noexcept
+{
+    if (buffer.size() < WireLayout::kHeaderSize)
+        return WireError::Incomplete;
+    const std::byte* data{ buffer.data() };
+    uint16_t length{ wire_detail::load<uint16_t>(data) };
+    uint16_t type{ wire_detail::load<uint16_t>(data + 2) };
+
+    std::size_t expected{ WireLayout::frameSize(type) };
+    if (expected == 0)
+        return WireError::UnknownType;
+    if (length != expected)
+        return WireError::BadLength;
+    if (wire_detail::load<uint16_t>(data + 4) != WireLayout::kSchemaVersion)
+        return WireError::BadVersion;
+    if (buffer.size() < expected)
+        return WireError::Incomplete;
+    if (wire_detail::load<uint16_t>(data + 6) != 0)
+        return WireError::BadField;
+
+    const std::byte* body{ data + WireLayout::kHeaderSize };
+    switch (static_cast<WireType>(type))
+    {
+        case WireType::NewOrder:
+            if (!WireOrderFields::valid(body))
+                return WireError::BadField;
+            break;
+        case WireType::Replace:
+            if (!WireOrderFields::valid(body + 8))
+                return WireError::BadField;
+            break;
+        case WireType::ExecutionReport:
+            if (std::to_integer<uint8_t>(body[48]) > static_cast<uint8_t>(ExecStatus::ReplaceRejected)
+                || (wire_detail::load<uint64_t>(body + 48) >> 8) != 0)
+                return WireError::BadField;
+            break;
+        case WireType::Cancel:
+            break;
+    }
+    frame = WireFrame{ data, static_cast<WireType>(type) };
+    return WireError::None;
+}
+
+// Pass every whole frame at the front of buffer to handler(const WireFrame&).
+// Stops at the end of the buffer, at a partial frame (Incomplete: keep the
+// tail and retry with more bytes) or at a malformed one (the stream cannot
+// be resynchronized). consumed is the number of bytes of handled frames.
+template <typename Handler>
+WireError decodeFrames(std::span<const std::byte> buffer, std::size_t& consumed, Handler&& handler)
+{
+    consumed = 0;
+    WireFrame frame;
+    while (consumed < buffer.size())
+    {
+        WireError error{ peekFrame(buffer.subspan(consumed), frame) };
+        if (error != WireError::None)
+            return error;
+        handler(frame);
+        consumed += frame.size();
+    }
+    return WireError::None;
+}
+
+// Encoders write one frame at out and return its size, 0 if out is too small
+
+namespace wire_detail
+{
+inline void header(std::byte* out, WireType type) noexcept
+{
+    store<uint16_t>(out, static_cast<uint16_t>(WireLayout::frameSize(static_cast<uint16_t>(type))));
+    store<uint16_t>(out + 2, static_cast<uint16_t>(type));
+    store<uint16_t>(out + 4, WireLayout::kSchemaVersion);
+    store<uint16_t>(out + 6, 0);
+}
+} // namespace wire_detail
+
+inline std::size_t encodeNewOrder(std::span<std::byte> out, const Order& order) noexcept
+{
+    if (out.size() < WireLayout::kNewOrderSize)
+        return 0;
+    wire_detail::header(out.data(), WireType::NewOrder);
+    WireOrderFields::encode(out.data() + WireLayout::kHeaderSize, order);
+    return WireLayout::kNewOrderSize;
+}
+
+inline std::size_t encodeCancel(std::span<std::byte> out, uint64_t id) noexcept
+{
+    if (out.size() < WireLayout::kCancelSize)
+        return 0;
+    wire_detail::header(out.data(), WireType::Cancel);
+    wire_detail::store<uint64_t>(out.data() + WireLayout::kHeaderSize, id);
+    return WireLayout::kCancelSize;
+}
+
+inline std::size_t encodeReplace(std::span<std::byte> out, uint64_t id, const Order& replacement) noexcept
+{
+    if (out.size() < WireLayout::kReplaceSize)
+        return 0;
+    wire_detail::header(out.data(), WireType::Replace);
+    wire_detail::store<uint64_t>(out.data() + WireLayout::kHeaderSize, id);
+    WireOrderFields::encode(out.data() + WireLayout::kHeaderSize + 8, replacement);
+    return WireLayout::kReplaceSize;
+}
+
+inline std::size_t encodeExecutionReport(std::span<std::byte> out, const ExecutionReport& report) noexcept
+{
+    if (out.size() < WireLayout::kExecutionReportSize)
+        return 0;
+    wire_detail::header(out.data(), WireType::ExecutionReport);
+    std::byte* body{ out.data() + WireLayout::kHeaderSize };
+    wire_detail::store<uint64_t>(body, report.id);
+    wire_detail::store<int64_t>(body + 8, report.price.raw());
+    wire_detail::store<uint64_t>(body + 16, report.quantity);
+    wire_detail::store<uint64_t>(body + 24, report.filledQty);
+    wire_detail::store<uint64_t>(body + 32, report.leavesQty);
+    wire_detail::store<int64_t>(body + 40, report.avgFillPrice.raw());
+    body[48] = static_cast<std::byte>(report.status);
+    std::memset(body + 49, 0, 7);
+    return WireLayout::kExecutionReportSize;
+}
+
+#endif // WIRE_PROTOCOL_HPP
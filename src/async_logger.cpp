@@ -0,0 +1,95 @@
+#include "../include/async_logger.hpp"
+#include "../include/logger.hpp"
+#include <charconv>
+#include <ctime>
+
+AsyncTradeLogger::AsyncTradeLogger(const std::string& filename, OverflowPolicy policy)
+    : _policy{ policy }
+{
+    std::filesystem::path logFile = Logger::resolvePath(filename);
+    _file.open(logFile, std::ios::out | std::ios::app);
+    if (!_file.is_open())
+        std::cerr << "[Logger Error] Cannot open: " << logFile << std::endl;
+
+    _wallOffset = std::chrono::system_clock::now().time_since_epoch()
+                - std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                      std::chrono::steady_clock::now().time_since_epoch());
+    _thread = std::thread(&AsyncTradeLogger::run, this);
+}
+
+AsyncTradeLogger::~AsyncTradeLogger()
+{
+    _running.store(false, std::memory_order_release);
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void AsyncTradeLogger::flush() const
+{
+    while (_written.load(std::memory_order_acquire) < _accepted)
+        std::this_thread::yield();
+}
+
+void AsyncTradeLogger::run()
+{
+    std::string buffer;
+    buffer.reserve(kBatchSize * 64);
+    uint64_t written{ 0 };
+
+    while (true)
+    {
+        std::span<TradeRecord> batch{ _ring.claimRead(kBatchSize) };
+        if (batch.empty())
+        {
+            // Records pushed before stop are visible once _running reads false
+            if (!_running.load(std::memory_order_acquire) && _ring.empty())
+                break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+
+        buffer.clear();
+        for (const auto& record : batch)
+            format(record, buffer);
+        _ring.commitRead(batch.size());
+        _file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        _file.flush();
+
+        written += batch.size();
+        _written.store(written, std::memory_order_release);
+    }
+}
+
+void AsyncTradeLogger::format(const TradeRecord& record, std::string& out)
+{
+    auto wall{ std::chrono::duration_cast<std::chrono::seconds>(
+        record.timestamp.time_since_epoch()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(_wallOffset)) };
+    std::time_t second{ static_cast<std::time_t>(wall.count()) };
+    if (second != _cachedSecond)
+    {
+        std::tm local{};
+        localtime_r(&second, &local);
+        std::strftime(_timePrefix, sizeof(_timePrefix), "[%H:%M:%S] ", &local);
+        _cachedSecond = second;
+    }
+
+    // Same layout as Logger::log("TRADE ", buy, "->", sell, " qty=", q, " price=", p)
+    char line[128];
+    char* p{ line };
+    char* end{ line + sizeof(line) };
+    auto append = [&p](const char* text) { while (*text) *p++ = *text++; };
+
+    append(_timePrefix);
+    append("TRADE  ");
+    p = std::to_chars(p, end, record.buy_id).ptr;
+    append("->");
+    p = std::to_chars(p, end, record.sell_id).ptr;
+    append(" qty=");
+    p = std::to_chars(p, end, record.quantity).ptr;
+    append(" price=");
+    p = std::to_chars(p, end, Price::fromRaw(record.price_raw).toDouble()).ptr;
+    *p++ = '\n';
+
+    out.append(line, p);
+}
@@ -0,0 +1,113 @@
+#include "../include/order_book.hpp"
+#include <algorithm>
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+AuctionResult BasicOrderBook<TradeSink, PriceMapping, Storage>::equilibrium(std::size_t& index) const
+{
+    // Only prices between the best ask and the best bid can execute anything
+    std::size_t low{ _asks.best() };
+    std::size_t high{ _bids.best() };
+    if (low == PriceLadder::npos || high == PriceLadder::npos || high < low)
+        return {};
+
+    std::size_t count{ high - low + 1 };
+    _auctionDemand.resize(count);
+    _auctionSupply.resize(count);
+    uint64_t* demand{ _auctionDemand.data() };
+    uint64_t* supply{ _auctionSupply.data() };
+    _bids.copyQuantities(low, count, demand);
+    _asks.copyQuantities(low, count, supply);
+
+    // demand[k]: bids at or above level low + k, supply[k]: asks at or below it
+    for (std::size_t k{ count - 1 }; k-- > 0;)
+        demand[k] += demand[k + 1];
+    for (std::size_t k{ 1 }; k < count; ++k)
+        supply[k] += supply[k - 1];
+
+    // Branch-free reductions: maximum executable volume, then the smallest
+    // imbalance among the levels that reach it
+    uint64_t volume{ 0 };
+    for (std::size_t k{ 0 }; k < count; ++k)
+        volume = std::max(volume, std::min(demand[k], supply[k]));
+    uint64_t minImbalance{ UINT64_MAX };
+    for (std::size_t k{ 0 }; k < count; ++k)
+    {
+        uint64_t imbalance{ demand[k] > supply[k] ? demand[k] - supply[k] : supply[k] - demand[k] };
+        uint64_t candidate{ std::min(demand[k], supply[k]) == volume ? imbalance : UINT64_MAX };
+        minImbalance = std::min(minImbalance, candidate);
+    }
+
+    std::size_t first{ count };
+    std::size_t last{ 0 };
+    for (std::size_t k{ 0 }; k < count; ++k)
+    {
+        uint64_t imbalance{ demand[k] > supply[k] ? demand[k] - supply[k] : supply[k] - demand[k] };
+        if (std::min(demand[k], supply[k]) == volume && imbalance == minImbalance)
+        {
+            first = std::min(first, k);
+            last = k;
+        }
+    }
+
+    // Remaining ties follow the surplus: buy pressure takes the highest
+    // price, sell pressure the lowest, a balanced book the middle
+    int64_t surplus{ static_cast<int64_t>(demand[first]) - static_cast<int64_t>(supply[first]) };
+    std::size_t chosen{ surplus > 0 ? last : surplus < 0 ? first : first + (last - first) / 2 };
+    index = low + chosen;
+    return { indexToPrice(index), volume,
+             static_cast<int64_t>(demand[chosen]) - static_cast<int64_t>(supply[chosen]) };
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+AuctionResult BasicOrderBook<TradeSink, PriceMapping, Storage>::indicativeUncross() const
+{
+    std::size_t index{ 0 };
+    return equilibrium(index);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+AuctionResult BasicOrderBook<TradeSink, PriceMapping, Storage>::uncross()
+{
+    std::size_t index{ 0 };
+    AuctionResult result{ equilibrium(index) };
+    _phase = TradingPhase::Continuous;
+    _fillQty = 0;
+    _fillNotional = 0;
+    _activations.clear();
+
+    // Bids at or above the price and asks at or below it hold at least
+    // `volume` each; pair them off best first, FIFO within a level
+    auto timestamp{ std::chrono::steady_clock::now() };
+    uint64_t remaining{ result.volume };
+    while (remaining > 0)
+    {
+        std::size_t bidIndex{ _bids.best() };
+        std::size_t askIndex{ _asks.best() };
+        auto& bidLevel{ _bids.level(bidIndex) };
+        auto& askLevel{ _asks.level(askIndex) };
+        Order& buyOrder{ _orders[bidLevel.head].order };
+        Order& sellOrder{ _orders[askLevel.head].order };
+
+        uint64_t qty{ std::min({ buyOrder.quantity, sellOrder.quantity, remaining }) };
+        emitTrade(Trade{ buyOrder.id, sellOrder.id, result.price, qty, timestamp, buyOrder.instrument });
+        remaining -= qty;
+
+        buyOrder.quantity -= qty;
+        bidLevel.quantity -= qty;
+        if (buyOrder.quantity == 0)
+            popFront(Side::Buy, bidIndex);
+        else
+            notifyLevel(Side::Buy, bidIndex, bidLevel.quantity);
+
+        sellOrder.quantity -= qty;
+        askLevel.quantity -= qty;
+        if (sellOrder.quantity == 0)
+            popFront(Side::Sell, askIndex);
+        else
+            notifyLevel(Side::Sell, askIndex, askLevel.quantity);
+    }
+    // Stops triggered by the uncross price fire in continuous trading
+    fireStops(timestamp);
+    maybeRecenter();
+    return result;
+}
@@ -0,0 +1,114 @@
+#include "../include/order_book.hpp"
+#include "../include/book_snapshot.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::saveSnapshot(const std::string& path, uint64_t inputSequence) const
+{
+    std::vector<SnapshotOrder> orders;
+    orders.reserve(_orders.size());
+    auto collect = [&orders](const Order& order) {
+        orders.push_back({ order.id, order.price.raw(), order.quantity, order.instrument,
+                           static_cast<uint8_t>(order.type) });
+    };
+    forEachOrder(Side::Buy, collect);
+    std::size_t bids{ orders.size() };
+    forEachOrder(Side::Sell, collect);
+
+    std::vector<SnapshotStop> stops;
+    for (const PriceLadder* levels : { &_buyStops, &_sellStops })
+        for (std::size_t i{ levels->best() }; i != PriceLadder::npos; i = levels->nextAfter(i))
+            for (uint32_t node{ levels->find(i)->head }; node != Storage::npos; node = _orders[node].next)
+            {
+                const Order& order{ _orders[node].order };
+                stops.push_back({ { order.id, order.price.raw(), order.quantity, order.instrument,
+                                    static_cast<uint8_t>(order.type) },
+                                  order.stopPrice.raw(), static_cast<uint8_t>(order.side) });
+            }
+
+    SnapshotHeader header{ SnapshotHeader::kMagic, inputSequence, _trades.nextSequence(),
+                           _minPrice.raw(), _maxPrice.raw(), _mapping.tick(), static_cast<uint32_t>(bids),
+                           static_cast<uint32_t>(orders.size() - bids), static_cast<uint8_t>(_phase),
+                           static_cast<uint8_t>(_hasLastTrade), {}, static_cast<uint32_t>(stops.size()),
+                           _lastTrade.raw(), _tradeLow.raw(), _tradeHigh.raw() };
+
+    // Write next to the target and rename, so a crash never leaves a torn snapshot
+    std::string tmp{ path + ".tmp" };
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(orders.data()),
+                   static_cast<std::streamsize>(orders.size() * sizeof(SnapshotOrder)));
+        file.write(reinterpret_cast<const char*>(stops.data()),
+                   static_cast<std::streamsize>(stops.size() * sizeof(SnapshotStop)));
+        if (!file.flush())
+            throw std::runtime_error("cannot write snapshot " + tmp);
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        throw std::runtime_error("cannot rename snapshot to " + path);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+uint64_t BasicOrderBook<TradeSink, PriceMapping, Storage>::loadSnapshot(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    SnapshotHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != SnapshotHeader::kMagic)
+        throw std::runtime_error("not a book snapshot: " + path);
+    if (header.minPrice_raw != _minPrice.raw() || header.maxPrice_raw != _maxPrice.raw() || header.tickSize_raw != _mapping.tick())
+        throw std::runtime_error("snapshot price grid does not match the book: " + path);
+    if (_orders.size() != 0)
+        throw std::runtime_error("snapshot must be loaded into an empty book");
+
+    std::vector<SnapshotOrder> orders(std::size_t{ header.bidCount } + header.askCount);
+    std::vector<SnapshotStop> stops(header.stopCount);
+    if (!file.read(reinterpret_cast<char*>(orders.data()),
+                   static_cast<std::streamsize>(orders.size() * sizeof(SnapshotOrder)))
+        || !file.read(reinterpret_cast<char*>(stops.data()),
+                      static_cast<std::streamsize>(stops.size() * sizeof(SnapshotStop))))
+        throw std::runtime_error("truncated book snapshot: " + path);
+
+    _orders.reserve(orders.size() + stops.size());
+
+    // Orders of a level are contiguous in the file, so the level tail being
+    // linked is always hot; the id index is the only random access left and
+    // is prefetched a few orders ahead
+    constexpr std::size_t kPrefetchDistance{ 16 };
+    Order order;
+    for (std::size_t i{ 0 }; i < orders.size(); ++i)
+    {
+        if (i + kPrefetchDistance < orders.size())
+            _orders.prefetch(orders[i + kPrefetchDistance].id);
+
+        const SnapshotOrder& entry{ orders[i] };
+        order.id = entry.id;
+        order.side = i < header.bidCount ? Side::Buy : Side::Sell;
+        order.type = static_cast<OrderType>(entry.type);
+        order.price = Price::fromRaw(entry.price_raw);
+        order.quantity = entry.quantity;
+        order.instrument = entry.instrument;
+        addOrder(order);
+    }
+    for (const SnapshotStop& entry : stops)
+    {
+        order.id = entry.order.id;
+        order.side = static_cast<Side>(entry.side);
+        order.type = static_cast<OrderType>(entry.order.type);
+        order.price = Price::fromRaw(entry.order.price_raw);
+        order.quantity = entry.order.quantity;
+        order.instrument = entry.order.instrument;
+        order.stopPrice = Price::fromRaw(entry.stop_raw);
+        armStop(order);
+    }
+    _hasLastTrade = header.hasLastTrade != 0;
+    _lastTrade = Price::fromRaw(header.lastTrade_raw);
+    _tradeLow = Price::fromRaw(header.tradeLow_raw);
+    _tradeHigh = Price::fromRaw(header.tradeHigh_raw);
+    _trades.resume(header.tradeSequence);
+    _phase = static_cast<TradingPhase>(header.phase);
+    maybeRecenter();
+    return header.inputSequence;
+}
@@ -0,0 +1,51 @@
+#include "../include/order_book.hpp"
+#include <algorithm>
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+std::size_t BasicOrderBook<TradeSink, PriceMapping, Storage>::depth(Side side, std::span<DepthLevel> out) const
+{
+    const PriceLadder& levels{ side == Side::Buy ? _bids : _asks };
+    std::size_t n{ 0 };
+    for (std::size_t i{ levels.best() }; i != PriceLadder::npos && n < out.size(); i = levels.nextAfter(i))
+    {
+        const PriceLevel* level{ levels.find(i) };
+        out[n++] = { indexToPrice(i), level->quantity, level->size() };
+    }
+    return n;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+uint64_t BasicOrderBook<TradeSink, PriceMapping, Storage>::cumulativeDepth(Side side, Price limit) const noexcept
+{
+    const PriceLadder& levels{ side == Side::Buy ? _bids : _asks };
+    uint64_t total{ 0 };
+    for (std::size_t i{ levels.best() }; i != PriceLadder::npos; i = levels.nextAfter(i))
+    {
+        Price price{ indexToPrice(i) };
+        if (side == Side::Buy ? price < limit : price > limit)
+            break;
+        total += levels.find(i)->quantity;
+    }
+    return total;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+FillEstimate BasicOrderBook<TradeSink, PriceMapping, Storage>::estimateFill(Side takerSide, uint64_t quantity,
+                                                                            std::optional<Price> limit) const noexcept
+{
+    // An incoming buy takes asks from the lowest up, a sell bids from the highest down
+    const PriceLadder& levels{ takerSide == Side::Buy ? _asks : _bids };
+    FillEstimate estimate;
+    for (std::size_t i{ levels.best() }; i != PriceLadder::npos && estimate.quantity < quantity; i = levels.nextAfter(i))
+    {
+        Price price{ indexToPrice(i) };
+        if (limit && (takerSide == Side::Buy ? price > *limit : price < *limit))
+            break;
+        uint64_t take{ std::min(levels.find(i)->quantity, quantity - estimate.quantity) };
+        estimate.quantity += take;
+        if (!addNotional(estimate.notional, price, take))
+            estimate.saturated = true;
+        ++estimate.levels;
+    }
+    return estimate;
+}
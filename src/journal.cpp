@@ -0,0 +1,42 @@
+#include "../include/journal.hpp"
+#include <filesystem>
+
+Journal::Journal(const std::string& path)
+{
+    constexpr std::size_t kHeader{ sizeof(JournalFileHeader) };
+    std::error_code error;
+    auto size{ std::filesystem::file_size(path, error) };
+    if (error)
+        size = 0;
+
+    if (size >= kHeader)
+    {
+        JournalFileHeader header;
+        std::ifstream existing(path, std::ios::binary);
+        if (!existing.read(reinterpret_cast<char*>(&header), sizeof(header)) || !header.matches())
+            throw std::runtime_error("unsupported journal format in " + path);
+        // Cut a record torn by a crash, so appended records stay aligned
+        std::size_t torn{ (size - kHeader) % sizeof(JournalRecord) };
+        if (torn != 0)
+            std::filesystem::resize_file(path, size - torn);
+    }
+    else if (size > 0)
+    {
+        std::filesystem::resize_file(path, 0); // the header itself was torn
+        size = 0;
+    }
+
+    _file.open(path, std::ios::binary | std::ios::app);
+    if (!_file)
+        throw std::runtime_error("cannot open journal " + path);
+    if (size == 0)
+    {
+        JournalFileHeader header;
+        _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+Journal::~Journal()
+{
+    _file.flush();
+}
@@ -1,10 +1,15 @@
 #include "../include/matching_engine.hpp"
 #include "../include/order_book.hpp"
 #include "../include/spscqueue.hpp"
+#include "../include/mpscqueue.hpp"
+#include "../include/order_flow.hpp"
+#include "../include/pipeline.hpp"
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 // Вспомогательные функции для красивого вывода
 
@@ -19,7 +24,13 @@ void printSeparator() {
 }
 
 std::string orderTypeToString(OrderType type) {
-    return (type == OrderType::Limit) ? "LIMIT" : "MARKET";
+    switch (type) {
+        case OrderType::Limit:     return "LIMIT";
+        case OrderType::Market:    return "MARKET";
+        case OrderType::Stop:      return "STOP";
+        case OrderType::StopLimit: return "STOP_LIMIT";
+    }
+    return "UNKNOWN";
 }
 
 std::string sideToString(Side side) {
@@ -174,14 +185,15 @@ void demo5_MatchingEngine() {
     std::cout << "\n2. Execution Reports:\n";
     printSeparator();
 
-    const auto& reports = engine.getReports();
-    for (const auto& report : reports) {
+    // Отчёты читаются из потока с номерами последовательности
+    uint64_t cursor = 0;
+    engine.getReports().poll(cursor, [](uint64_t, const ExecutionReport& report) {
         std::cout << "  Order #" << std::setw(2) << report.id
                   << " | Status: " << std::setw(16) << std::left << report.status
                   << " | Price: $" << std::fixed << std::setprecision(2)
                   << std::setw(7) << std::right << report.price
                   << " | Qty: " << report.quantity << "\n";
-    }
+    });
 
     std::cout << "\n3. Состояние OrderBook:\n";
     printSeparator();
@@ -252,118 +264,155 @@ void demo6_TradingSession() {
 }
 
 // Сценарий 7: SPSC Queue и многопоточность
-void demo7_SPSCMultithreading() {
-    printHeader("СЦЕНАРИЙ 7: Lock-free SPSC Queue и многопоточность");
+void demo7_Pipeline() {
+    printHeader("СЦЕНАРИЙ 7: Конвейер ingest → sequence → match → publish");
+
+    std::cout << "\nПотоки стадий соединены lock-free очередями (MPSC на входе, дальше SPSC):\n";
+    std::cout << "  - Ingest (поток-гейтвей): кладёт заявки, штамп TSC на входе\n";
+    std::cout << "  - Sequence: единая нумерация входящих сообщений\n";
+    std::cout << "  - Match: pre-trade риск + движок в одном потоке\n";
+    std::cout << "  - Publish: отчёты потребителю, задержка от входа до публикации\n\n";
+
+    constexpr size_t kInputs = 100000;
+    constexpr AccountId kAccounts = 16;
+
+    // Один и тот же поток заявок для каждой стратегии ожидания
+    OrderFlowConfig flowConfig;
+    flowConfig.seed = 7;
+    OrderFlowGenerator generator(flowConfig);
+    std::vector<JournalRecord> inputs(kInputs);
+    generator.generate(inputs.data(), inputs.size());
+
+    // Busy-spin имеет смысл только когда у каждой стадии своё ядро
+    unsigned cores = std::thread::hardware_concurrency();
+    std::vector<WaitStrategy> strategies{ WaitStrategy::SpinYield, WaitStrategy::Futex };
+    if (cores >= 4) {
+        strategies.insert(strategies.begin(), WaitStrategy::BusySpin);
+    } else {
+        std::cout << "Ядер: " << cores << " — busy_spin пропущен (нужно >= 4)\n\n";
+    }
 
-    std::cout << "\nДемонстрация работы с lock-free очередью:\n";
-    std::cout << "  - Producer (поток 1): генерирует ордера и кладет в очередь\n";
-    std::cout << "  - Consumer (поток 2): забирает ордера и обрабатывает\n\n";
+    std::unique_ptr<Pipeline> pipeline;
+    for (WaitStrategy strategy : strategies) {
+        PipelineConfig config;
+        config.wait = { strategy, strategy, strategy };
+        if (cores >= 4) {
+            config.cpus = { 1, 2, 3 };
+        }
+        pipeline = std::make_unique<Pipeline>(config);
 
-    // Создаем SPSC очередь на 256 элементов
-    SPSCQueue<Order, 256> orderQueue;
-    MatchingEngine engine;
+        PreTradeRisk& risk = pipeline->enableRisk(kAccounts);
+        for (AccountId account = 0; account < kAccounts; ++account) {
+            risk.setLimits(account, { .maxOrderQty = 500, .priceCollar = 1.0, .maxPosition = 5000 });
+        }
+
+        std::atomic<uint64_t> rejected{0};
+        pipeline->setOnReport([&rejected](const ExecutionReport& report) {
+            if (report.status == ExecStatus::Rejected) {
+                rejected.store(rejected.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+        });
+
+        pipeline->start();
+        std::thread gateway([&]() {
+            if (cores >= 4) {
+                pinCurrentThread(0);
+            }
+            for (const JournalRecord& record : inputs) {
+                while (!pipeline->push(record, static_cast<AccountId>(record.id % kAccounts))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        gateway.join();
+        pipeline->stop();
+
+        pipeline->printReport(std::cout);
+        std::cout << "  отклонено риском: " << rejected.load() << "\n\n";
+    }
+
+    std::cout << "Латентность матчинга (последний прогон):\n";
+    printSeparator();
+    pipeline->engine().printMetrics();
+}
+
+void demo8_MPSCGateways() {
+    printHeader("СЦЕНАРИЙ 8: MPSC очередь — несколько гейтвеев, один движок");
+
+    std::cout << "\nНесколько потоков-гейтвеев кладут ордера в общую lock-free очередь,\n";
+    std::cout << "поток матчинга забирает их пакетами и обрабатывает на месте.\n\n";
+
+    constexpr size_t kGateways = 3;
+    constexpr uint64_t kOrdersPerGateway = 2000;
 
-    std::atomic<bool> producerDone{false};
-    std::atomic<size_t> ordersProduced{0};
-    std::atomic<size_t> ordersConsumed{0};
+    MPSCQueue<Order, 1024> orderQueue;
+    MatchingEngine engine{ LogMode::Off };
 
-    // PRODUCER: генерирует ордера
-    auto producer = [&]() {
-        std::cout << "[PRODUCER] Старт генерации ордеров...\n";
+    std::atomic<size_t> gatewaysDone{0};
+    size_t ordersConsumed = 0;
+    size_t batches = 0;
 
-        // Создаем начальную ликвидность
-        for (uint64_t i = 0; i < 20; ++i) {
+    // GATEWAY: каждый поток генерирует свой диапазон id
+    auto gateway = [&](size_t gatewayId) {
+        for (uint64_t i = 0; i < kOrdersPerGateway; ++i) {
+            uint64_t id = gatewayId * kOrdersPerGateway + i;
             Order order{
-                i,
-                (i % 2 == 0) ? Side::Sell : Side::Buy,
+                id,
+                (id % 2 == 0) ? Side::Sell : Side::Buy,
                 OrderType::Limit,
-                100.0 + (i % 5) * 0.5,  // Цены: 100.0, 100.5, 101.0, 101.5, 102.0
-                static_cast<uint64_t>(10 + (i % 3) * 5)
+                100.0 + static_cast<double>(id % 5) * 0.5,
+                static_cast<uint64_t>(10 + (id % 3) * 5)
             };
-
-            // Пытаемся положить в очередь
             while (!orderQueue.push(order)) {
-                std::this_thread::yield();  // Ждем, если очередь полна
+                std::this_thread::yield();
             }
-
-            ordersProduced++;
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
-
-        producerDone = true;
-        std::cout << "[PRODUCER] Завершил работу. Сгенерировано ордеров: " << ordersProduced << "\n";
+        gatewaysDone++;
     };
 
-    // CONSUMER: обрабатывает ордера батчами
+    // CONSUMER: тот же цикл, что в сценарии 7, но пакет обрабатывается прямо в слотах
     auto consumer = [&]() {
-        std::cout << "[CONSUMER] Старт обработки ордеров...\n";
-
-        std::vector<Order> batch;
-        batch.reserve(10);
-
-        while (!producerDone || ordersProduced != ordersConsumed) {
-            batch.clear();
-            size_t count = orderQueue.popBatch(batch, 10);
-
+        while (true) {
+            bool finished = gatewaysDone == kGateways;
+            size_t count = orderQueue.consume([&](Order& order) { engine.processOrder(order); }, 64);
             if (count > 0) {
-                std::cout << "[CONSUMER] Получен batch из " << count << " ордеров:\n";
-
-                for (const auto& order : batch) {
-                    engine.processOrder(order);
-                    ordersConsumed++;
-
-                    std::cout << "  └─ Order #" << order.id
-                              << " | " << sideToString(order.side)
-                              << " | " << orderTypeToString(order.type)
-                              << " | $" << std::fixed << std::setprecision(2) << order.price
-                              << " | Qty: " << order.quantity << "\n";
-                }
+                ordersConsumed += count;
+                batches++;
+            } else if (finished) {
+                break;
             } else {
-                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                std::this_thread::yield();
             }
         }
-
-        std::cout << "[CONSUMER] Завершил работу. Обработано ордеров: " << ordersConsumed << "\n";
     };
 
     auto startTime = std::chrono::high_resolution_clock::now();
 
-    // Запускаем потоки
-    std::thread producerThread(producer);
+    std::vector<std::thread> gatewayThreads;
+    for (size_t g = 0; g < kGateways; ++g) {
+        gatewayThreads.emplace_back(gateway, g);
+    }
     std::thread consumerThread(consumer);
 
-    // Ждем завершения
-    producerThread.join();
+    for (auto& thread : gatewayThreads) {
+        thread.join();
+    }
     consumerThread.join();
 
     auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
 
-    std::cout << "\n📊 РЕЗУЛЬТАТЫ МНОГОПОТОЧНОЙ ОБРАБОТКИ\n";
+    std::cout << "📊 РЕЗУЛЬТАТЫ\n";
     printSeparator();
-    std::cout << "  Сгенерировано ордеров:    " << ordersProduced << "\n";
+    std::cout << "  Гейтвеев:                 " << kGateways << "\n";
     std::cout << "  Обработано ордеров:       " << ordersConsumed << "\n";
+    std::cout << "  Пакетов:                  " << batches << "\n";
     std::cout << "  Всего сделок:             " << engine.getOrderBook().getTrades().size() << "\n";
-    std::cout << "  Время выполнения:         " << duration.count() << " мс\n";
-    std::cout << "  Throughput:               "
-              << std::fixed << std::setprecision(1)
-              << (ordersConsumed.load() * 1000.0 / duration.count()) << " ордеров/сек\n";
-
-    std::cout << "\nСостояние OrderBook после многопоточной обработки:\n";
-    printSeparator();
-    engine.getOrderBook().printBook();
+    std::cout << "  Время выполнения:         " << duration.count() << " мкс\n";
 
-    std::cout << "\nExecution Reports (последние 5):\n";
+    std::cout << "\nЛатентность (перцентили по классам ордеров):\n";
     printSeparator();
-    const auto& reports = engine.getReports();
-    size_t start = reports.size() > 5 ? reports.size() - 5 : 0;
-    for (size_t i = start; i < reports.size(); ++i) {
-        const auto& report = reports[i];
-        std::cout << "  Order #" << std::setw(2) << report.id
-                  << " | " << std::setw(16) << std::left << report.status << std::right
-                  << " | $" << std::fixed << std::setprecision(2) << std::setw(7) << report.price
-                  << " | Qty: " << report.quantity << "\n";
-    }
+    engine.printMetrics();
 }
 
 // Главное меню
@@ -377,7 +426,8 @@ void showMenu() {
     std::cout << "    4. Частичное исполнение ордеров\n";
     std::cout << "    5. MatchingEngine с execution reports\n";
     std::cout << "    6. Симуляция торговой сессии (с метриками)\n";
-    std::cout << "    7. SPSC Queue + многопоточность (Producer/Consumer)\n";
+    std::cout << "    7. Конвейер потоков: ingest → sequence → match → publish\n";
+    std::cout << "    8. MPSC Queue: несколько гейтвеев (Producers/Consumer)\n";
     std::cout << "    0. Выход\n";
     std::cout << "\n  Ввод: ";
 }
@@ -392,7 +442,7 @@ int main() {
         if (std::cin.fail()) {
             std::cin.clear();
             std::cin.ignore(10000, '\n');
-            std::cout << "\nНекорректный ввод! Введите число от 0 до 7.\n";
+            std::cout << "\nНекорректный ввод! Введите число от 0 до 8.\n";
             continue;
         }
 
@@ -416,13 +466,16 @@ int main() {
                 demo6_TradingSession();
                 break;
             case 7:
-                demo7_SPSCMultithreading();
+                demo7_Pipeline();
+                break;
+            case 8:
+                demo8_MPSCGateways();
                 break;
             case 0:
                 std::cout << "\nДо свидания!\n\n";
                 return 0;
             default:
-                std::cout << "\nНеверный выбор! Введите число от 0 до 7.\n";
+                std::cout << "\nНеверный выбор! Введите число от 0 до 8.\n";
         }
 
         std::cout << "\n\nНажмите Enter для продолжения...";
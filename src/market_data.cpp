@@ -0,0 +1,101 @@
+#include "../include/market_data.hpp"
+#include <algorithm>
+#include <thread>
+
+MarketDataPublisher::MarketDataPublisher(OrderBook& book, std::size_t snapshotDepth, uint64_t snapshotInterval)
+    : _book{ book }, _pendingIndex{ kQueueSize }, _snapshotDepth{ snapshotDepth },
+        _snapshotInterval{ snapshotInterval }, _bidLevels(snapshotDepth), _askLevels(snapshotDepth)
+{
+    _pending.reserve(kQueueSize);
+    _book.setOnLevelUpdateCallback([this](Side side, Price price, uint64_t quantity) {
+        onLevelUpdate(side, price, quantity);
+    });
+}
+
+void MarketDataPublisher::onLevelUpdate(Side side, Price price, uint64_t quantity) noexcept
+{
+    if (pendingLevels() > 0)
+        flush();
+
+    uint32_t pending{ pendingLevels() > 0 ? _pendingIndex.find(key(side, price)) : OrderIndex::npos };
+    if (pending != OrderIndex::npos)
+    {
+        _pending[pending].quantity = quantity;
+        _conflated.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (!send(side, price, quantity))
+    {
+        _pendingIndex.insert(key(side, price), static_cast<uint32_t>(_pending.size()));
+        _pending.push_back({ 0, side, price, quantity });
+    }
+
+    if (_snapshotInterval != 0 && ++_sinceSnapshot >= _snapshotInterval)
+        publishSnapshot();
+}
+
+bool MarketDataPublisher::send(Side side, Price price, uint64_t quantity) noexcept
+{
+    if (!_updates.push({ _sequence + 1, side, price, quantity }))
+        return false;
+    ++_sequence;
+    return true;
+}
+
+void MarketDataPublisher::flush() noexcept
+{
+    while (_pendingHead < _pending.size())
+    {
+        const LevelUpdate& level{ _pending[_pendingHead] };
+        if (!send(level.side, level.price, level.quantity))
+            return;
+        _pendingIndex.erase(key(level.side, level.price));
+        ++_pendingHead;
+    }
+    _pending.clear();
+    _pendingHead = 0;
+}
+
+void MarketDataPublisher::publishSnapshot() noexcept
+{
+    _sinceSnapshot = 0;
+
+    uint64_t version{ _snapshotVersion.load(std::memory_order_relaxed) };
+    _snapshotVersion.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto copySide = [this](Side side, std::vector<DepthLevel>& levels, std::atomic<std::size_t>& count) {
+        count.store(_book.depth(side, levels), std::memory_order_relaxed);
+    };
+    copySide(Side::Buy, _bidLevels, _snapshotBids);
+    copySide(Side::Sell, _askLevels, _snapshotAsks);
+    // Unsent conflated levels are newer than the snapshot's sequence; they
+    // will still be delivered with higher sequence numbers
+    _snapshotSequence.store(_sequence, std::memory_order_relaxed);
+
+    _snapshotVersion.store(version + 2, std::memory_order_release);
+}
+
+bool MarketDataPublisher::readSnapshot(DepthSnapshot& out) const
+{
+    for (;;)
+    {
+        uint64_t before{ _snapshotVersion.load(std::memory_order_acquire) };
+        if (before == 0)
+            return false;
+        if (before & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::size_t bids{ std::min(_snapshotBids.load(std::memory_order_relaxed), _snapshotDepth) };
+        std::size_t asks{ std::min(_snapshotAsks.load(std::memory_order_relaxed), _snapshotDepth) };
+        out.sequence = _snapshotSequence.load(std::memory_order_relaxed);
+        out.bids.assign(_bidLevels.begin(), _bidLevels.begin() + bids);
+        out.asks.assign(_askLevels.begin(), _askLevels.begin() + asks);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_snapshotVersion.load(std::memory_order_relaxed) == before)
+            return true;
+    }
+}
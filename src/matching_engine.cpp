@@ -1,58 +1,26 @@
 #include "../include/matching_engine.hpp"
-#include <iostream>
 
-MatchingEngine::MatchingEngine():
-    _orderBook{}, _logger{ "trades.log" }, _reports{}
+const char* toString(ExecStatus status) noexcept
 {
-    _orderBook.setOnTradeCallback([this](const Trade& t) {
-        _logger.log("TRADE ",
-                    t.buy_id, "->", t.sell_id,
-                    " qty=", t.quantity,
-                    " price=", t.price);
-    });
-}
-
-void MatchingEngine::processOrder(Order order) noexcept
-{
-    ExecutionReport report;
-    report.id = order.id;
-    report.price = order.price;
-    report.quantity = order.quantity;
-
-    auto start = std::chrono::high_resolution_clock::now();
-    _orderBook.processOrder(order);
-    auto end = std::chrono::high_resolution_clock::now();
-
-    _metrics.processed_orders++;
-    double latency = std::chrono::duration<double, std::micro>(end - start).count();
-    _metrics.avg_latency_us += (latency - _metrics.avg_latency_us) / _metrics.processed_orders;
-
-    if (!_orderBook.getTrades().empty())
+    switch (status)
     {
-        report.status = (_orderBook.getLastOrder().quantity == 0) ? "filled" : "partially_filled";
-        _metrics.executed_trades = _orderBook.getTrades().size();
+        case ExecStatus::Accepted:        return "accepted";
+        case ExecStatus::Filled:          return "filled";
+        case ExecStatus::PartiallyFilled: return "partially_filled";
+        case ExecStatus::Rejected:        return "rejected";
+        case ExecStatus::Canceled:        return "canceled";
+        case ExecStatus::Reduced:         return "reduced";
+        case ExecStatus::Replaced:        return "replaced";
+        case ExecStatus::CancelRejected:  return "cancel_rejected";
+        case ExecStatus::ReduceRejected:  return "reduce_rejected";
+        case ExecStatus::ReplaceRejected: return "replace_rejected";
     }
-    else
-    {
-        report.status = "accepted";
-    }
-    _reports.emplace_back(report);
+    return "unknown";
 }
 
-void MatchingEngine::printReports() const noexcept
+std::ostream& operator<<(std::ostream& os, ExecStatus status)
 {
-    std::cout << "--- Execution Reports ---\n";
-    for (const auto& r : _reports) {
-        std::cout << "Order " << r.id
-                  << " [" << r.status << "] qty=" << r.quantity
-                  << " @ " << r.price << std::endl;
-    }
+    return os << toString(status);
 }
 
-void MatchingEngine::processBatchOrders(const std::vector<Order>& orders)
-{
-    for (const auto& order : orders)
-    {
-        processOrder(order);
-    }
-}
\ No newline at end of file
+template class BasicMatchingEngine<ReportStream>;
@@ -0,0 +1,326 @@
+#include "../include/matching_engine.hpp"
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+template <typename Sink>
+template <typename... SinkArgs>
+BasicMatchingEngine<Sink>::BasicMatchingEngine(LogMode logMode, const OrderBookConfig& bookConfig,
+                                               SinkArgs&&... sinkArgs):
+    _orderBook{ bookConfig }, _reports(std::forward<SinkArgs>(sinkArgs)...)
+{
+    if (logMode == LogMode::Sync)
+        _logger = std::make_unique<Logger>("trades.log");
+    else if (logMode == LogMode::Async)
+        _asyncLogger = std::make_unique<AsyncTradeLogger>("trades.log");
+
+    if (!_logger && !_asyncLogger)
+        return;
+    _orderBook.setOnTradeCallback([this](const Trade& t) {
+        if (_asyncLogger)
+        {
+            _asyncLogger->log(t);
+        }
+        else
+        {
+            _logger->log("TRADE ",
+                        t.buy_id, "->", t.sell_id,
+                        " qty=", t.quantity,
+                        " price=", t.price);
+        }
+    });
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::processOrder(Order order) noexcept
+{
+    journal(JournalRecord::fromOrder(0, JournalKind::New, order));
+    if (!_orderBook.acceptsOrder(order))
+    {
+        rejectOrder(order);
+        return;
+    }
+    execute(order);
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::execute(Order order) noexcept
+{
+    uint64_t tradesBefore{ _orderBook.getTrades().nextSequence() };
+    uint64_t start{ TscClock::now() };
+    _orderBook.processOrder(order);
+    uint64_t latency{ TscClock::now() - start };
+
+    bump(_metrics.processed_orders, 1);
+
+    uint64_t newTrades{ _orderBook.getTrades().nextSequence() - tradesBefore };
+    bump(_metrics.executed_trades, newTrades);
+
+    if (order.type == OrderType::Market)
+        _metrics.sweep_latency.record(latency);
+    else if (newTrades > 0)
+        _metrics.match_latency.record(latency);
+    else
+        _metrics.add_latency.record(latency);
+
+    _reports.publish(fillReport(order));
+    for (const StopActivation& activation : _orderBook.lastActivations())
+        _reports.publish(activationReport(activation));
+}
+
+template <typename Sink>
+ExecutionReport BasicMatchingEngine<Sink>::fillReport(const Order& order) const noexcept
+{
+    ExecutionReport report{ order.id, ExecStatus::Accepted, order.price, order.quantity };
+    uint64_t remaining{ _orderBook.getLastOrder().quantity };
+    if (_orderBook.lastFillQty() > 0)
+    {
+        uint64_t filled{ _orderBook.lastFillQty() };
+        report.status = remaining == 0 ? ExecStatus::Filled : ExecStatus::PartiallyFilled;
+        report.filledQty = filled;
+        report.avgFillPrice = averagePrice(_orderBook.lastFillNotional(), filled);
+    }
+    // Market orders are not accepted during the call phase
+    if (order.type == OrderType::Market && _orderBook.phase() == TradingPhase::Auction)
+        report.status = ExecStatus::Rejected;
+    // Market order remainders are dropped, limit remainders rest, stops stay armed
+    report.leavesQty = order.type == OrderType::Market ? 0 : remaining;
+    return report;
+}
+
+template <typename Sink>
+ExecutionReport BasicMatchingEngine<Sink>::activationReport(const StopActivation& activation) const noexcept
+{
+    ExecutionReport report{ activation.id, ExecStatus::Accepted, activation.price, activation.quantity };
+    report.leavesQty = activation.leavesQty;
+    if (activation.filledQty > 0)
+    {
+        report.status = activation.filledQty == activation.quantity ? ExecStatus::Filled : ExecStatus::PartiallyFilled;
+        report.filledQty = activation.filledQty;
+        report.avgFillPrice = averagePrice(activation.fillNotional, activation.filledQty);
+    }
+    return report;
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::cancelOrder(uint64_t id) noexcept
+{
+    journal({ 0, JournalKind::Cancel, 0, 0, 0, 0, 0, id, 0, 0 });
+    ExecutionReport report{ id, ExecStatus::CancelRejected, 0.0, 0 };
+    if (const Order* resting = _orderBook.findOrder(id))
+    {
+        report = { id, ExecStatus::Canceled, resting->price, resting->quantity };
+        _orderBook.cancelOrder(id);
+    }
+    _reports.publish(report);
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::rejectOrder(const Order& order) noexcept
+{
+    _reports.publish({ order.id, ExecStatus::Rejected, order.price, order.quantity });
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::reduceOrder(uint64_t id, uint64_t newQuantity) noexcept
+{
+    journal({ 0, JournalKind::Reduce, 0, 0, 0, 0, 0, id, 0, newQuantity });
+    ExecutionReport report{ id, ExecStatus::ReduceRejected, 0.0, newQuantity };
+    if (const Order* resting = _orderBook.findOrder(id))
+    {
+        report.price = resting->price;
+        report.leavesQty = resting->quantity;
+        if (_orderBook.reduceOrder(id, newQuantity))
+        {
+            report.status = newQuantity == 0 ? ExecStatus::Canceled : ExecStatus::Reduced;
+            report.leavesQty = newQuantity;
+        }
+    }
+    _reports.publish(report);
+}
+
+template <typename Sink>
+bool BasicMatchingEngine<Sink>::replaceOrder(uint64_t id, Order replacement) noexcept
+{
+    journal(JournalRecord::fromOrder(0, JournalKind::Replace, replacement, id));
+    if (!_orderBook.acceptsOrder(replacement) || !_orderBook.cancelOrder(id))
+    {
+        _reports.publish({ id, ExecStatus::ReplaceRejected, replacement.price, replacement.quantity });
+        return false;
+    }
+    _reports.publish({ id, ExecStatus::Replaced, replacement.price, replacement.quantity });
+    execute(replacement);
+    return true;
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::startAuction() noexcept
+{
+    journal({ 0, JournalKind::Auction, 0, 0, 0, 0, 0, 0, 0, 0 });
+    _orderBook.startAuction();
+}
+
+template <typename Sink>
+AuctionResult BasicMatchingEngine<Sink>::uncross() noexcept
+{
+    journal({ 0, JournalKind::Uncross, 0, 0, 0, 0, 0, 0, 0, 0 });
+    uint64_t tradesBefore{ _orderBook.getTrades().nextSequence() };
+    AuctionResult result{ _orderBook.uncross() };
+    bump(_metrics.executed_trades, _orderBook.getTrades().nextSequence() - tradesBefore);
+    for (const StopActivation& activation : _orderBook.lastActivations())
+        _reports.publish(activationReport(activation));
+    return result;
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::apply(const JournalRecord& record) noexcept
+{
+    switch (record.kind)
+    {
+        case JournalKind::New:     processOrder(record.toOrder()); break;
+        case JournalKind::Cancel:  cancelOrder(record.targetId); break;
+        case JournalKind::Reduce:  reduceOrder(record.targetId, record.quantity); break;
+        case JournalKind::Replace: replaceOrder(record.targetId, record.toOrder()); break;
+        case JournalKind::Auction: startAuction(); break;
+        case JournalKind::Uncross: uncross(); break;
+    }
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::journal(JournalRecord record)
+{
+    record.sequence = ++_inputSequence;
+    if (_journal)
+        _journal->append(record);
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::openJournal(const std::string& path)
+{
+    _journal = std::make_unique<Journal>(path);
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::saveSnapshot(const std::string& path)
+{
+    if (_journal)
+        _journal->flush();
+    _orderBook.saveSnapshot(path, _inputSequence);
+}
+
+template <typename Sink>
+uint64_t BasicMatchingEngine<Sink>::recover(const std::string& snapshotPath, const std::string& journalPath)
+{
+    _inputSequence = std::filesystem::exists(snapshotPath) ? _orderBook.loadSnapshot(snapshotPath) : 0;
+
+    // Replayed inputs are already in the journal
+    auto journal{ std::move(_journal) };
+    Journal::replay(journalPath, _inputSequence + 1, [this](const JournalRecord& record) {
+        _inputSequence = record.sequence - 1;
+        apply(record);
+    });
+    _journal = std::move(journal);
+    return _inputSequence;
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::printReports() const noexcept
+{
+    std::cout << "--- Execution Reports ---\n";
+    uint64_t cursor{ 0 };
+    _reports.poll(cursor, [](uint64_t, const ExecutionReport& r) {
+        std::cout << "Order " << r.id
+                  << " [" << r.status << "] qty=" << r.quantity
+                  << " @ " << r.price << std::endl;
+    });
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::printMetrics() const
+{
+    auto line = [](const char* name, const LatencyHistogram& histogram) {
+        HistogramSnapshot snap{ histogram.snapshot() };
+        std::cout << std::left << std::setw(8) << name << std::right
+                  << " n=" << std::setw(8) << snap.count << std::fixed << std::setprecision(0)
+                  << " p50=" << std::setw(7) << TscClock::toNanos(snap.percentile(50.0)) << "ns"
+                  << " p99=" << std::setw(7) << TscClock::toNanos(snap.percentile(99.0)) << "ns"
+                  << " p99.9=" << std::setw(7) << TscClock::toNanos(snap.percentile(99.9)) << "ns"
+                  << " max=" << std::setw(7) << TscClock::toNanos(snap.max) << "ns\n";
+    };
+
+    std::cout << "--- Metrics ---\n"
+              << "orders=" << _metrics.processed_orders.load(std::memory_order_relaxed)
+              << " trades=" << _metrics.executed_trades.load(std::memory_order_relaxed) << "\n";
+    line("add", _metrics.add_latency);
+    line("sweep", _metrics.sweep_latency);
+    line("match", _metrics.match_latency);
+    line("batch", _metrics.batch_latency);
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::flushLog() const
+{
+    if (_asyncLogger)
+        _asyncLogger->flush();
+}
+
+template <typename Sink>
+void BasicMatchingEngine<Sink>::processBatchOrders(std::span<const Order> orders)
+{
+    constexpr std::size_t kPrefetchAhead{ 4 };
+    if (orders.empty())
+        return;
+
+    bool logging{ _logger || _asyncLogger };
+    _batchReports.clear();
+    _batchTrades.clear();
+    if (logging)
+        _orderBook.captureTrades(&_batchTrades);
+
+    for (std::size_t i{ 0 }; i < kPrefetchAhead && i < orders.size(); ++i)
+        _orderBook.prefetch(orders[i]);
+
+    auto timestamp{ std::chrono::steady_clock::now() };
+    uint64_t tradesStart{ _orderBook.getTrades().nextSequence() };
+    uint64_t processed{ 0 };
+    uint64_t start{ TscClock::now() };
+    for (std::size_t i{ 0 }; i < orders.size(); ++i)
+    {
+        if (i + kPrefetchAhead < orders.size())
+            _orderBook.prefetch(orders[i + kPrefetchAhead]);
+
+        const Order& order{ orders[i] };
+        journal(JournalRecord::fromOrder(0, JournalKind::New, order));
+        if (!_orderBook.acceptsOrder(order))
+        {
+            _batchReports.push_back({ order.id, ExecStatus::Rejected, order.price, order.quantity });
+            continue;
+        }
+        _orderBook.processOrder(order, timestamp);
+        ++processed;
+        _batchReports.push_back(fillReport(order));
+        for (const StopActivation& activation : _orderBook.lastActivations())
+            _batchReports.push_back(activationReport(activation));
+    }
+    uint64_t latency{ TscClock::now() - start };
+    if (logging)
+        _orderBook.captureTrades(nullptr);
+
+    // Rejected orders are not counted, as on the per-order path
+    bump(_metrics.processed_orders, processed);
+    bump(_metrics.executed_trades, _orderBook.getTrades().nextSequence() - tradesStart);
+    _metrics.batch_latency.record(latency / orders.size());
+
+    std::span<const ExecutionReport> reports{ _batchReports };
+    if constexpr (requires { _reports.publish(reports); })
+        _reports.publish(reports);
+    else
+        for (const ExecutionReport& report : reports)
+            _reports.publish(report);
+
+    if (_asyncLogger)
+        _asyncLogger->log(std::span<const Trade>{ _batchTrades });
+    else if (_logger)
+        for (const Trade& t : _batchTrades)
+            _logger->log("TRADE ", t.buy_id, "->", t.sell_id, " qty=", t.quantity, " price=", t.price);
+}
@@ -0,0 +1,76 @@
+#include "../include/mpscqueue.hpp"
+
+template <typename T, std::size_t N>
+MPSCQueue<T, N>::MPSCQueue()
+{
+    for (std::size_t i{ 0 }; i < N; ++i)
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T, std::size_t N>
+bool MPSCQueue<T, N>::push(const T& item)
+{
+    std::size_t head{ _head.load(std::memory_order_relaxed) };
+
+    for (;;)
+    {
+        Slot& slot{ _slots[head & kMask] };
+        std::size_t sequence{ slot.sequence.load(std::memory_order_acquire) };
+        auto diff{ static_cast<std::ptrdiff_t>(sequence - head) };
+
+        if (diff == 0)
+        {
+            // Slot is free for this lap; on failure head is reloaded
+            if (_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+            {
+                slot.item = item;
+                slot.sequence.store(head + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Consumer has not released the slot from the previous lap
+            return false;
+        }
+        else
+        {
+            // Another producer took this position
+            head = _head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, std::size_t N>
+bool MPSCQueue<T, N>::pop(T& item)
+{
+    return consume([&item](T& value) { item = value; }, 1) == 1;
+}
+
+template <typename T, std::size_t N>
+std::size_t MPSCQueue<T, N>::popBatch(std::vector<T>& out, std::size_t maxSize)
+{
+    return consume([&out](T& value) { out.push_back(value); }, maxSize);
+}
+
+template <typename T, std::size_t N>
+template <typename Handler>
+std::size_t MPSCQueue<T, N>::consume(Handler&& handler, std::size_t maxSize)
+{
+    std::size_t tail{ _tail.load(std::memory_order_relaxed) };
+    std::size_t count{ 0 };
+
+    while (count < maxSize)
+    {
+        Slot& slot{ _slots[(tail + count) & kMask] };
+        if (slot.sequence.load(std::memory_order_acquire) != tail + count + 1)
+            break;
+        handler(slot.item);
+        slot.sequence.store(tail + count + N, std::memory_order_release);
+        ++count;
+    }
+
+    if (count > 0)
+        _tail.store(tail + count, std::memory_order_release);
+    return count;
+}
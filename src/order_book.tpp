@@ -0,0 +1,395 @@
+#include "../include/order_book.hpp"
+#include <algorithm>
+#include <iostream>
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::processOrder(Order order, std::chrono::steady_clock::time_point timestamp)
+{
+    _fillQty = 0;
+    _fillNotional = 0;
+    _activations.clear();
+    if (isStop(order))
+    {
+        // Armed in either phase; it may already be triggered by the last trade
+        if (order.quantity > 0)
+            armStop(order);
+        _lastOrder = order;
+        fireStops(timestamp);
+        maybeRecenter();
+        return;
+    }
+    if (_phase == TradingPhase::Auction)
+    {
+        // Call phase: collect limit orders until uncross(), drop market orders
+        if (order.type == OrderType::Limit && order.quantity > 0)
+            addOrder(order);
+        _lastOrder = order;
+        maybeRecenter();
+        return;
+    }
+    match(order, timestamp);
+    _lastOrder = order;
+    fireStops(timestamp);
+    maybeRecenter();
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::match(Order& order, std::chrono::steady_clock::time_point timestamp)
+{
+    if (order.type == OrderType::Market)
+    {
+        if (order.side == Side::Buy)
+        {
+            auto bestAsk { getBestAskIndex() };
+            while (bestAsk != SIZE_MAX && order.quantity > 0)
+            {
+                auto& queue{ _asks.level(bestAsk) };
+                Order& sellOrder{ _orders[queue.head].order };
+
+                uint64_t qty{ std::min(order.quantity, sellOrder.quantity) };
+                Trade trade{ order.id, sellOrder.id, sellOrder.price, qty, timestamp, order.instrument };
+                emitTrade(trade);
+
+                sellOrder.quantity -= qty;
+                order.quantity -= qty;
+                queue.quantity -= qty;
+
+                if (sellOrder.quantity == 0)
+                {
+                    popFront(Side::Sell, bestAsk);
+                    bestAsk = getBestAskIndex();
+                }
+                else
+                    notifyLevel(Side::Sell, bestAsk, queue.quantity);
+            }
+        }
+        else if (order.side == Side::Sell)
+        {
+            auto bestBid { getBestBidIndex() };
+            while (bestBid != SIZE_MAX && order.quantity > 0)
+            {
+                auto& queue{ _bids.level(bestBid) };
+                Order& buyOrder{ _orders[queue.head].order };
+
+                uint64_t qty{ std::min(order.quantity, buyOrder.quantity) };
+                Trade trade{ buyOrder.id, order.id, buyOrder.price, qty, timestamp, order.instrument };
+                emitTrade(trade);
+
+                buyOrder.quantity -= qty;
+                order.quantity -= qty;
+                queue.quantity -= qty;
+
+                if (buyOrder.quantity == 0)
+                {
+                    popFront(Side::Buy, bestBid);
+                    bestBid = getBestBidIndex();
+                }
+                else
+                    notifyLevel(Side::Buy, bestBid, queue.quantity);
+            }
+        }
+    }
+    else if (order.type == OrderType::Limit)
+    {
+        if (order.side == Side::Buy)
+        {
+            auto bestAsk { getBestAskIndex() };
+            if (bestAsk != SIZE_MAX  && order.price >= indexToPrice(bestAsk))
+            {
+                auto& queue{ _asks.level(bestAsk) };
+                Order& sellOrder{ _orders[queue.head].order };
+
+                uint64_t qty { std::min(sellOrder.quantity, order.quantity) };
+                Trade trade{ order.id, sellOrder.id, sellOrder.price, qty, timestamp, order.instrument };
+                emitTrade(trade);
+
+                sellOrder.quantity -= qty;
+                order.quantity -= qty;
+                queue.quantity -= qty;
+
+                if (sellOrder.quantity == 0)
+                    popFront(Side::Sell, bestAsk);
+                else
+                    notifyLevel(Side::Sell, bestAsk, queue.quantity);
+                if (order.quantity > 0)
+                    addOrder(order);
+            }
+            else
+                addOrder(order);
+        }
+        else if (order.side == Side::Sell)
+        {
+            auto bestBid { getBestBidIndex() };
+            if (bestBid != SIZE_MAX && order.price <= indexToPrice(bestBid))
+            {
+                auto& queue{ _bids.level(bestBid) };
+                Order& buyOrder{ _orders[queue.head].order };
+                
+                uint64_t qty { std::min(buyOrder.quantity, order.quantity) };
+                Trade trade{ buyOrder.id, order.id, buyOrder.price, qty, timestamp, order.instrument };
+                emitTrade(trade);
+
+                buyOrder.quantity -= qty;
+                order.quantity -= qty;
+                queue.quantity -= qty;
+
+                if (buyOrder.quantity == 0)
+                    popFront(Side::Buy, bestBid);
+                else
+                    notifyLevel(Side::Buy, bestBid, queue.quantity);
+                if (order.quantity > 0)
+                    addOrder(order);
+            }
+            else 
+                addOrder(order);
+        }
+    }
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::armStop(const Order& order)
+{
+    std::size_t index{ priceToIndex(order.stopPrice) };
+    PriceLadder& levels{ stopLadder(order.side) };
+    auto& level{ levels.level(index) };
+    uint32_t node{ _orders.allocate(order) };
+
+    pushBack(level, node);
+    _orders.insert(order.id, node);
+    if (level.size() == 1)
+        levels.onFilled(index);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+uint32_t BasicOrderBook<TradeSink, PriceMapping, Storage>::nextTriggeredStop() noexcept
+{
+    std::size_t buy{ _buyStops.best() };
+    if (buy != PriceLadder::npos && buy <= priceToIndex(_tradeHigh))
+        return _buyStops.level(buy).head;
+    std::size_t sell{ _sellStops.best() };
+    if (sell != PriceLadder::npos && sell >= priceToIndex(_tradeLow))
+        return _sellStops.level(sell).head;
+    return Storage::npos;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::fireStops(std::chrono::steady_clock::time_point timestamp)
+{
+    if (!_hasLastTrade || _phase == TradingPhase::Auction)
+        return;
+
+    // lastFillQty/lastFillNotional keep describing the order that was processed
+    uint64_t fillQty{ _fillQty };
+    int64_t fillNotional{ _fillNotional };
+    for (std::size_t fired{ 0 };; ++fired)
+    {
+        uint32_t node{ nextTriggeredStop() };
+        if (node == Storage::npos)
+        {
+            // Complete pass: later triggers compare against new trades only
+            _tradeLow = _lastTrade;
+            _tradeHigh = _lastTrade;
+            break;
+        }
+        if (fired == _maxStopCascade)
+            break; // the rest fire on the next call, against the same range
+
+        Order order{ _orders[node].order };
+        unlinkNode(stopLadder(order.side), priceToIndex(order.stopPrice), node);
+        order.type = order.type == OrderType::Stop ? OrderType::Market : OrderType::Limit;
+
+        uint64_t quantity{ order.quantity };
+        _fillQty = 0;
+        _fillNotional = 0;
+        match(order, timestamp);
+        _activations.push_back({ order.id, order.type, order.price, quantity, _fillQty, _fillNotional,
+                                 order.type == OrderType::Limit ? order.quantity : 0 });
+    }
+    _fillQty = fillQty;
+    _fillNotional = fillNotional;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::addOrder(const Order& order) noexcept
+{
+    std::size_t index{ priceToIndex(order.price) };
+
+    auto& level{ ladder(order.side).level(index) };
+    uint32_t node{ _orders.allocate(order) };
+
+    pushBack(level, node);
+    _orders.insert(order.id, node);
+    if (level.size() == 1)
+        ladder(order.side).onFilled(index);
+    notifyLevel(order.side, index, level.quantity);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+bool BasicOrderBook<TradeSink, PriceMapping, Storage>::cancelOrder(uint64_t id) noexcept
+{
+    uint32_t node{ _orders.find(id) };
+    if (node == Storage::npos)
+        return false;
+
+    const Order& order{ _orders[node].order };
+    if (isStop(order))
+        unlinkNode(stopLadder(order.side), priceToIndex(order.stopPrice), node);
+    else
+        unlink(order.side, priceToIndex(order.price), node);
+    return true;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+bool BasicOrderBook<TradeSink, PriceMapping, Storage>::reduceOrder(uint64_t id, uint64_t newQuantity) noexcept
+{
+    uint32_t node{ _orders.find(id) };
+    if (node == Storage::npos)
+        return false;
+
+    Order& order{ _orders[node].order };
+    if (newQuantity >= order.quantity)
+        return false;
+    if (isStop(order))
+    {
+        // Armed stops are not part of the visible book: no level updates
+        std::size_t index{ priceToIndex(order.stopPrice) };
+        if (newQuantity == 0)
+        {
+            unlinkNode(stopLadder(order.side), index, node);
+        }
+        else
+        {
+            stopLadder(order.side).level(index).quantity -= order.quantity - newQuantity;
+            order.quantity = newQuantity;
+        }
+        return true;
+    }
+    std::size_t index{ priceToIndex(order.price) };
+    if (newQuantity == 0)
+    {
+        unlink(order.side, index, node);
+    }
+    else
+    {
+        auto& level{ ladder(order.side).level(index) };
+        level.quantity -= order.quantity - newQuantity;
+        order.quantity = newQuantity;
+        notifyLevel(order.side, index, level.quantity);
+    }
+    return true;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+bool BasicOrderBook<TradeSink, PriceMapping, Storage>::replaceOrder(uint64_t id, Order replacement)
+{
+    if (!cancelOrder(id))
+        return false;
+    processOrder(replacement);
+    return true;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+const Order* BasicOrderBook<TradeSink, PriceMapping, Storage>::findOrder(uint64_t id) const noexcept
+{
+    uint32_t node{ _orders.find(id) };
+    return node == Storage::npos ? nullptr : &_orders[node].order;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::pushBack(PriceLevel& level, uint32_t node) noexcept
+{
+    _orders[node].prev = level.tail;
+    if (level.tail != OrderPool::npos)
+        _orders[level.tail].next = node;
+    else
+        level.head = node;
+    level.tail = node;
+    ++level.count;
+    level.quantity += _orders[node].order.quantity;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::popFront(Side side, size_t index) noexcept
+{
+    unlink(side, index, ladder(side).level(index).head);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::unlink(Side side, size_t index, uint32_t node) noexcept
+{
+    notifyLevel(side, index, unlinkNode(ladder(side), index, node));
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+uint64_t BasicOrderBook<TradeSink, PriceMapping, Storage>::unlinkNode(PriceLadder& levels, size_t index, uint32_t node) noexcept
+{
+    auto& level{ levels.level(index) };
+    OrderNode& entry{ _orders[node] };
+
+    if (entry.prev != OrderPool::npos)
+        _orders[entry.prev].next = entry.next;
+    else
+        level.head = entry.next;
+    if (entry.next != OrderPool::npos)
+        _orders[entry.next].prev = entry.prev;
+    else
+        level.tail = entry.prev;
+    --level.count;
+    level.quantity -= entry.order.quantity;
+    uint64_t remaining{ level.quantity };
+
+    // A duplicate id may have overwritten the mapping; only drop our own
+    if (_orders.find(entry.order.id) == node)
+        _orders.erase(entry.order.id);
+    _orders.release(node);
+
+    if (level.empty())
+        levels.onEmptied(index);
+    return remaining;
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::maybeRecenter()
+{
+    std::size_t window{ _bids.windowSize() };
+    if (window == _numPriceLevels)
+        return;
+
+    std::size_t bid{ _bids.best() };
+    std::size_t ask{ _asks.best() };
+    if (bid == PriceLadder::npos && ask == PriceLadder::npos)
+        return;
+
+    // The book may be momentarily crossed, so do not assume bid < ask
+    std::size_t mid{ bid == PriceLadder::npos ? ask
+                   : ask == PriceLadder::npos ? bid
+                   : std::min(bid, ask) + (std::max(bid, ask) - std::min(bid, ask)) / 2 };
+    std::size_t offset{ mid - _bids.base() };
+    if (offset >= window / 4 && offset < window - window / 4)
+        return;
+
+    std::size_t base{ mid > window / 2 ? mid - window / 2 : 0 };
+    _bids.recenter(base);
+    _asks.recenter(base);
+    _buyStops.recenter(base);
+    _sellStops.recenter(base);
+}
+
+template <typename TradeSink, typename PriceMapping, typename Storage>
+void BasicOrderBook<TradeSink, PriceMapping, Storage>::printBook() const noexcept
+{
+    std::cout << "--- Asks ---\n";
+    for (size_t i = _asks.best(); i != PriceLadder::npos; i = _asks.nextAfter(i))
+    {
+        Price price = indexToPrice(i);
+        std::cout << price << " (" << _asks.find(i)->size() << " orders)\n";
+    }
+
+    std::cout << "--- Bids ---\n";
+    for (size_t i = _bids.best(); i != PriceLadder::npos; i = _bids.nextAfter(i))
+    {
+        Price price = indexToPrice(i);
+        std::cout << price << " (" << _bids.find(i)->size() << " orders)\n";
+    }
+    std::cout << std::endl;
+}
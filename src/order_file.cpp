@@ -0,0 +1,47 @@
+#include "../include/order_file.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OrderFile::OrderFile(const std::string& path)
+{
+    int fd{ ::open(path.c_str(), O_RDONLY) };
+    if (fd < 0)
+        throw std::runtime_error("cannot open order file " + path);
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("cannot stat order file " + path);
+    }
+    _bytes = static_cast<std::size_t>(info.st_size);
+    if (_bytes < sizeof(JournalFileHeader))
+    {
+        ::close(fd);
+        throw std::runtime_error("unsupported order file format in " + path);
+    }
+
+    _data = ::mmap(nullptr, _bytes, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    ::close(fd);
+    if (_data == MAP_FAILED)
+        throw std::runtime_error("cannot map order file " + path);
+
+    JournalFileHeader header;
+    std::memcpy(&header, _data, sizeof(header));
+    if (!header.matches())
+    {
+        ::munmap(_data, _bytes);
+        throw std::runtime_error("unsupported order file format in " + path);
+    }
+    // Records are consumed front to back exactly once
+    ::madvise(_data, _bytes, MADV_SEQUENTIAL);
+}
+
+OrderFile::~OrderFile()
+{
+    ::munmap(_data, _bytes);
+}
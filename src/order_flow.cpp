@@ -0,0 +1,164 @@
+#include "../include/order_flow.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+
+uint64_t splitmix64(uint64_t& state) noexcept
+{
+    uint64_t z{ state += 0x9E3779B97F4A7C15ULL };
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+} // namespace
+
+OrderFlowGenerator::OrderFlowGenerator(const OrderFlowConfig& config)
+    : _config{ config }, _tick{ Price{ config.tickSize }.raw() }
+{
+    if (_tick <= 0)
+        throw std::invalid_argument("order flow: tick size must be positive");
+    if (config.limitPercent + config.marketPercent + config.cancelPercent != 100)
+        throw std::invalid_argument("order flow: limit, market and cancel percents must add up to 100");
+    if (config.aggressivePercent > 100)
+        throw std::invalid_argument("order flow: aggressive percent above 100");
+    if (config.arrivalRate <= 0.0 || config.tickRate < 0.0 || config.meanDepthTicks < 0.0)
+        throw std::invalid_argument("order flow: rates and depth must not be negative");
+    if (config.meanSize == 0 || config.maxSize < config.meanSize || config.cancelWindow == 0)
+        throw std::invalid_argument("order flow: bad size or cancel window");
+
+    // Round the bounds inwards onto the tick grid
+    _minTicks = (Price{ config.minPrice }.raw() + _tick - 1) / _tick;
+    _maxTicks = Price{ config.maxPrice }.raw() / _tick;
+    _midTicks = std::clamp(Price{ config.startPrice }.raw() / _tick, _minTicks, _maxTicks);
+    if (_minTicks > _maxTicks)
+        throw std::invalid_argument("order flow: empty price range");
+
+    // xoshiro256** seeded through splitmix64, as its authors recommend
+    uint64_t seed{ config.seed };
+    for (uint64_t& word : _state)
+        word = splitmix64(seed);
+
+    _recent.resize(config.cancelWindow);
+    if (config.tickRate > 0.0)
+        _nextMove = exponential(1.0 / config.tickRate);
+}
+
+uint64_t OrderFlowGenerator::random() noexcept
+{
+    uint64_t result{ rotl(_state[1] * 5, 7) * 9 };
+    uint64_t t{ _state[1] << 17 };
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = rotl(_state[3], 45);
+    return result;
+}
+
+double OrderFlowGenerator::uniform() noexcept
+{
+    return static_cast<double>((random() >> 11) + 1) * 0x1.0p-53;
+}
+
+double OrderFlowGenerator::exponential(double mean) noexcept
+{
+    return -std::log(uniform()) * mean;
+}
+
+uint64_t OrderFlowGenerator::size() noexcept
+{
+    switch (_config.sizeDistribution)
+    {
+        case SizeDistribution::Fixed:
+            return _config.meanSize;
+        case SizeDistribution::Uniform:
+            return 1 + random() % (2 * _config.meanSize - 1);
+        case SizeDistribution::Geometric:
+            break;
+    }
+    // 1 + Exp(meanSize - 1) rounded down: geometric with the requested mean
+    auto drawn{ 1 + static_cast<uint64_t>(exponential(static_cast<double>(_config.meanSize - 1))) };
+    return std::min(drawn, _config.maxSize);
+}
+
+Price OrderFlowGenerator::clampTicks(int64_t ticks) const noexcept
+{
+    return Price::fromRaw(std::clamp(ticks, _minTicks, _maxTicks) * _tick);
+}
+
+JournalRecord OrderFlowGenerator::next() noexcept
+{
+    _clock += exponential(1.0 / _config.arrivalRate);
+    if (_config.tickRate > 0.0)
+    {
+        while (_nextMove <= _clock)
+        {
+            _midTicks = std::clamp(_midTicks + ((random() & 1) != 0 ? 1 : -1), _minTicks, _maxTicks);
+            _nextMove += exponential(1.0 / _config.tickRate);
+        }
+    }
+
+    auto roll{ static_cast<unsigned>(random() % 100) };
+    if (roll >= _config.limitPercent + _config.marketPercent && _recentCount > 0)
+    {
+        std::size_t window{ std::min(_recentCount, _recent.size()) };
+        uint64_t target{ _recent[random() % window] };
+        return { ++_sequence, JournalKind::Cancel, 0, 0, 0, 0, 0, target, 0, 0 };
+    }
+
+    Side side{ (random() & 1) != 0 ? Side::Buy : Side::Sell };
+    int64_t direction{ side == Side::Buy ? 1 : -1 };
+    Order order{ _nextId++, side, OrderType::Limit, Price{}, size() };
+
+    if (roll >= _config.limitPercent && roll < _config.limitPercent + _config.marketPercent)
+    {
+        order.type = OrderType::Market;
+    }
+    else
+    {
+        auto distance{ static_cast<int64_t>(exponential(_config.meanDepthTicks)) };
+        bool aggressive{ random() % 100 < _config.aggressivePercent };
+        // Passive orders rest behind the mid, aggressive ones reach through it
+        order.price = clampTicks(aggressive ? _midTicks + direction * distance
+                                            : _midTicks - direction * (1 + distance));
+        _recent[_recentCount++ % _recent.size()] = order.id;
+    }
+    return JournalRecord::fromOrder(++_sequence, JournalKind::New, order);
+}
+
+void OrderFlowGenerator::generate(JournalRecord* out, std::size_t count) noexcept
+{
+    for (std::size_t i{ 0 }; i < count; ++i)
+        out[i] = next();
+}
+
+void writeOrderFlow(OrderFlowGenerator& generator, uint64_t count, const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("cannot create order file " + path);
+    JournalFileHeader header;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    constexpr std::size_t kChunk{ 1 << 16 };
+    std::vector<JournalRecord> buffer(kChunk);
+    while (count > 0)
+    {
+        auto chunk{ static_cast<std::size_t>(std::min<uint64_t>(count, kChunk)) };
+        generator.generate(buffer.data(), chunk);
+        file.write(reinterpret_cast<const char*>(buffer.data()),
+                   static_cast<std::streamsize>(chunk * sizeof(JournalRecord)));
+        count -= chunk;
+    }
+    file.flush();
+    if (!file)
+        throw std::runtime_error("cannot write order file " + path);
+}
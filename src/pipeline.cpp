@@ -0,0 +1,263 @@
+#include "../include/pipeline.hpp"
+#include <iomanip>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+inline void cpuRelax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+} // namespace
+
+const char* toString(WaitStrategy strategy) noexcept
+{
+    switch (strategy)
+    {
+        case WaitStrategy::BusySpin:  return "busy_spin";
+        case WaitStrategy::SpinYield: return "spin_yield";
+        case WaitStrategy::Futex:     return "futex";
+    }
+    return "unknown";
+}
+
+bool pinCurrentThread(unsigned cpu) noexcept
+{
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+Pipeline::Pipeline(const PipelineConfig& config)
+    : _config{ config },
+        _engine{ std::make_unique<PipelineEngine>(config.logMode, config.book, _published, _publishedBell) }
+{
+    // Producers only pay for the doorbell when their consumer may sleep
+    if (_config.wait[static_cast<std::size_t>(PipelineStage::Sequence)] == WaitStrategy::Futex)
+        _ingestBell.enable();
+    if (_config.wait[static_cast<std::size_t>(PipelineStage::Match)] == WaitStrategy::Futex)
+        _sequencedBell.enable();
+    if (_config.wait[static_cast<std::size_t>(PipelineStage::Publish)] == WaitStrategy::Futex)
+        _publishedBell.enable();
+}
+
+Pipeline::~Pipeline()
+{
+    stop();
+}
+
+PreTradeRisk& Pipeline::enableRisk(std::size_t accounts, std::size_t expectedOrders)
+{
+    if (_running)
+        throw std::logic_error("Risk must be enabled before start()");
+    _risk = std::make_unique<PreTradeRisk>(accounts, expectedOrders);
+    return *_risk;
+}
+
+void Pipeline::start()
+{
+    if (_running.exchange(true))
+        return;
+    _stopping = false;
+    _sequenceDone = false;
+    _matchDone = false;
+    _startTime = std::chrono::steady_clock::now();
+    _threads[0] = std::thread(&Pipeline::sequenceLoop, this);
+    _threads[1] = std::thread(&Pipeline::matchLoop, this);
+    _threads[2] = std::thread(&Pipeline::publishLoop, this);
+}
+
+void Pipeline::stop()
+{
+    if (!_running.load())
+        return;
+    // Ingest stores happen before stop(), so each stage sees them before
+    // the done flag of the stage above it
+    _stopping.store(true, std::memory_order_release);
+    _ingestBell.wakeAll();
+    for (auto& thread : _threads)
+        if (thread.joinable())
+            thread.join();
+    _stopTime = std::chrono::steady_clock::now();
+    _running = false;
+}
+
+bool Pipeline::push(const JournalRecord& record, AccountId account)
+{
+    if (!_ingest.push({ record, account, TscClock::now() }))
+        return false;
+    _ingestBell.ring();
+    return true;
+}
+
+void Pipeline::submit(const Order& order)
+{
+    JournalRecord record{ JournalRecord::fromOrder(0, JournalKind::New, order) };
+    while (!push(record, order.account))
+        std::this_thread::yield();
+}
+
+void Pipeline::cancel(uint64_t id)
+{
+    JournalRecord record{ 0, JournalKind::Cancel, 0, 0, 0, 0, 0, id, 0, 0 };
+    while (!push(record))
+        std::this_thread::yield();
+}
+
+template <typename Poll, typename HasInput>
+void Pipeline::runStage(PipelineStage stage, Doorbell& doorbell, const std::atomic<bool>& upstreamDone,
+                        Poll&& poll, HasInput&& hasInput)
+{
+    auto index{ static_cast<std::size_t>(stage) };
+    if (_config.cpus[index] >= 0)
+        pinCurrentThread(static_cast<unsigned>(_config.cpus[index]));
+
+    WaitStrategy wait{ _config.wait[index] };
+    uint32_t idlePolls{ 0 };
+    while (true)
+    {
+        if (poll() > 0)
+        {
+            idlePolls = 0;
+            continue;
+        }
+        if (upstreamDone.load(std::memory_order_acquire) && !hasInput())
+            break;
+
+        if (wait == WaitStrategy::BusySpin || ++idlePolls < _config.spinLimit)
+            cpuRelax();
+        else if (wait == WaitStrategy::SpinYield)
+            std::this_thread::yield();
+        else
+            doorbell.sleepUnless([&] { return hasInput() || upstreamDone.load(std::memory_order_acquire); });
+    }
+}
+
+void Pipeline::sequenceLoop()
+{
+    uint64_t sequence{ 0 };
+    auto poll = [&] {
+        std::size_t count{ _ingest.consume([&](PipelineInput& input) {
+            input.record.sequence = ++sequence;
+            while (!_sequenced.push(input))
+            {
+                _sequencedBell.ring();
+                std::this_thread::yield();
+            }
+        }, kBatchSize) };
+        if (count > 0)
+        {
+            _sequencedBell.ring();
+            _inputs.store(sequence, std::memory_order_relaxed);
+        }
+        return count;
+    };
+    runStage(PipelineStage::Sequence, _ingestBell, _stopping, poll, [this] { return !_ingest.empty(); });
+
+    _sequenceDone.store(true, std::memory_order_release);
+    _sequencedBell.wakeAll();
+}
+
+void Pipeline::matchLoop()
+{
+    auto poll = [&] {
+        std::span<PipelineInput> batch{ _sequenced.claimRead(kBatchSize) };
+        for (const PipelineInput& input : batch)
+            dispatch(input);
+        if (!batch.empty())
+        {
+            _sequenced.commitRead(batch.size());
+            _publishedBell.ring();
+        }
+        return batch.size();
+    };
+    runStage(PipelineStage::Match, _sequencedBell, _sequenceDone, poll, [this] { return !_sequenced.empty(); });
+
+    _matchDone.store(true, std::memory_order_release);
+    _publishedBell.wakeAll();
+}
+
+void Pipeline::dispatch(const PipelineInput& input)
+{
+    _engine->getReports().setIngress(input.ingressTicks);
+    const JournalRecord& record{ input.record };
+    if (!_risk)
+    {
+        _engine->apply(record);
+        return;
+    }
+
+    Order order{ record.toOrder() };
+    order.account = input.account;
+    switch (record.kind)
+    {
+        case JournalKind::New:     _risk->submit(*_engine, order); break;
+        case JournalKind::Cancel:  _risk->cancel(*_engine, record.targetId); break;
+        case JournalKind::Reduce:  _risk->reduce(*_engine, record.targetId, record.quantity); break;
+        case JournalKind::Replace: _risk->replace(*_engine, record.targetId, order); break;
+        default:
+            _engine->apply(record);
+            _risk->syncTrades(_engine->getOrderBook());
+            break;
+    }
+}
+
+void Pipeline::publishLoop()
+{
+    uint64_t reports{ 0 };
+    auto poll = [&] {
+        std::span<PipelineOutput> batch{ _published.claimRead(kBatchSize) };
+        if (batch.empty())
+            return std::size_t{ 0 };
+        uint64_t now{ TscClock::now() };
+        for (const PipelineOutput& output : batch)
+        {
+            _latency.record(now - output.ingressTicks);
+            if (_onReport)
+                _onReport(output.report);
+        }
+        _published.commitRead(batch.size());
+        reports += batch.size();
+        _reports.store(reports, std::memory_order_relaxed);
+        return batch.size();
+    };
+    runStage(PipelineStage::Publish, _publishedBell, _matchDone, poll, [this] { return !_published.empty(); });
+}
+
+PipelineReport Pipeline::report() const
+{
+    PipelineReport result;
+    result.inputs = _inputs.load(std::memory_order_relaxed);
+    result.reports = _reports.load(std::memory_order_relaxed);
+    auto end{ _running ? std::chrono::steady_clock::now() : _stopTime };
+    result.seconds = std::chrono::duration<double>(end - _startTime).count();
+    result.latency = _latency.snapshot();
+    return result;
+}
+
+void Pipeline::printReport(std::ostream& os) const
+{
+    PipelineReport result{ report() };
+    auto nanos = [&](double p) { return TscClock::toNanos(result.latency.percentile(p)); };
+    os << "--- Pipeline ---\n"
+       << "wait=" << toString(_config.wait[0]) << "/" << toString(_config.wait[1]) << "/" << toString(_config.wait[2])
+       << " inputs=" << result.inputs << " reports=" << result.reports
+       << std::fixed << std::setprecision(0) << " throughput=" << result.inputsPerSecond() << "/s\n"
+       << "end-to-end p50=" << nanos(50.0) << "ns p99=" << nanos(99.0) << "ns p99.9=" << nanos(99.9)
+       << "ns max=" << TscClock::toNanos(result.latency.max) << "ns\n";
+}
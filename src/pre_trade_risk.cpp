@@ -0,0 +1,198 @@
+#include "../include/pre_trade_risk.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+constexpr int64_t kMaxRaw{ std::numeric_limits<int64_t>::max() };
+constexpr int64_t kMinRaw{ std::numeric_limits<int64_t>::min() };
+
+// price.raw() * quantity, saturated at the int64 range instead of overflowing
+inline int64_t notional(int64_t price, uint64_t quantity) noexcept
+{
+    int64_t result;
+    if (quantity > static_cast<uint64_t>(kMaxRaw)
+        || __builtin_mul_overflow(price, static_cast<int64_t>(quantity), &result))
+        return price < 0 ? kMinRaw : kMaxRaw;
+    return result;
+}
+
+inline int64_t saturatingAdd(int64_t a, int64_t b) noexcept
+{
+    int64_t result;
+    if (__builtin_add_overflow(a, b, &result))
+        return b < 0 ? kMinRaw : kMaxRaw;
+    return result;
+}
+
+inline int64_t saturatingSub(int64_t a, int64_t b) noexcept
+{
+    int64_t result;
+    if (__builtin_sub_overflow(a, b, &result))
+        return b < 0 ? kMaxRaw : kMinRaw;
+    return result;
+}
+} // namespace
+
+const char* toString(RiskReject reason) noexcept
+{
+    switch (reason)
+    {
+        case RiskReject::None:           return "none";
+        case RiskReject::UnknownAccount: return "unknown_account";
+        case RiskReject::Throttled:      return "throttled";
+        case RiskReject::OrderSize:      return "order_size";
+        case RiskReject::PriceCollar:    return "price_collar";
+        case RiskReject::Position:       return "position";
+        case RiskReject::Notional:       return "notional";
+    }
+    return "unknown";
+}
+
+PreTradeRisk::PreTradeRisk(std::size_t accounts, std::size_t expectedOrders)
+    : _limits(accounts), _exposure(accounts), _index{ expectedOrders }
+{
+    _resting.reserve(expectedOrders);
+    _freeSlots.reserve(expectedOrders);
+}
+
+void PreTradeRisk::setLimits(AccountId account, const RiskLimits& limits)
+{
+    if (account >= _limits.size())
+        throw std::invalid_argument("risk account id out of range");
+    if (limits.priceCollar < 0.0 || limits.maxNotional < 0.0)
+        throw std::invalid_argument("risk limits must not be negative");
+
+    Limits& raw{ _limits[account] };
+    raw.maxOrderQty = limits.maxOrderQty;
+    raw.collar = Price{ limits.priceCollar }.raw();
+    raw.maxPosition = limits.maxPosition;
+    raw.maxNotional = static_cast<int64_t>(std::llround(limits.maxNotional * static_cast<double>(Price::kScale)));
+    raw.emissionTicks = 0;
+    raw.burstTicks = 0;
+    if (limits.maxMessagesPerSecond != 0)
+    {
+        double ticks{ 1e9 / (limits.maxMessagesPerSecond * TscClock::nanosPerTick()) };
+        raw.emissionTicks = std::max<uint64_t>(1, static_cast<uint64_t>(ticks));
+        raw.burstTicks = raw.emissionTicks * (std::max<uint32_t>(limits.burst, 1) - 1);
+    }
+}
+
+RiskReject PreTradeRisk::check(const Order& order, std::optional<Price> bestBid, std::optional<Price> bestAsk,
+                               uint64_t now) noexcept
+{
+    auto reject = [this](RiskReject reason) {
+        ++_rejected[static_cast<std::size_t>(reason)];
+        return reason;
+    };
+
+    if (order.account >= _limits.size())
+        return reject(RiskReject::UnknownAccount);
+    const Limits& limits{ _limits[order.account] };
+    AccountExposure& exposure{ _exposure[order.account] };
+    bool buy{ order.side == Side::Buy };
+
+    if (limits.emissionTicks != 0)
+    {
+        uint64_t arrival{ std::max(exposure.nextAllowed, now) };
+        if (arrival - now > limits.burstTicks)
+            return reject(RiskReject::Throttled);
+        exposure.nextAllowed = arrival + limits.emissionTicks;
+    }
+
+    // Exposure is signed: a quantity beyond int64 cannot be accounted for
+    if ((limits.maxOrderQty != 0 && order.quantity > limits.maxOrderQty)
+        || order.quantity > static_cast<uint64_t>(kMaxRaw))
+        return reject(RiskReject::OrderSize);
+
+    // Stops are sized at their trigger (Stop) or limit (StopLimit) price
+    std::optional<Price> opposite{ buy ? bestAsk : bestBid };
+    int64_t price{ order.type == OrderType::Stop ? order.stopPrice.raw() : order.price.raw() };
+    if (order.type == OrderType::Market)
+        price = opposite ? opposite->raw() + (buy ? limits.collar : -limits.collar) : 0;
+    else if (order.type == OrderType::Limit && limits.collar != 0 && opposite
+             && (buy ? price > opposite->raw() + limits.collar : price < opposite->raw() - limits.collar))
+        return reject(RiskReject::PriceCollar);
+
+    auto quantity{ static_cast<int64_t>(order.quantity) };
+    if (limits.maxPosition != 0)
+    {
+        int64_t worst{ (buy ? exposure.position : -exposure.position)
+                       + static_cast<int64_t>(buy ? exposure.openBuy : exposure.openSell) + quantity };
+        if (worst > static_cast<int64_t>(limits.maxPosition))
+            return reject(RiskReject::Position);
+    }
+
+    if (limits.maxNotional != 0
+        && saturatingAdd(exposure.openNotional, notional(price, order.quantity)) > limits.maxNotional)
+        return reject(RiskReject::Notional);
+
+    return RiskReject::None;
+}
+
+void PreTradeRisk::onTrade(const Trade& trade, const Order* aggressor) noexcept
+{
+    fill(trade.buy_id, Side::Buy, trade.quantity, aggressor);
+    fill(trade.sell_id, Side::Sell, trade.quantity, aggressor);
+}
+
+void PreTradeRisk::fill(uint64_t id, Side side, uint64_t quantity, const Order* aggressor) noexcept
+{
+    int64_t signedQty{ side == Side::Buy ? static_cast<int64_t>(quantity) : -static_cast<int64_t>(quantity) };
+    uint32_t slot{ _index.find(id) };
+    if (slot == OrderIndex::npos)
+    {
+        if (aggressor && aggressor->id == id && aggressor->account < _exposure.size())
+            _exposure[aggressor->account].position += signedQty;
+        return;
+    }
+
+    // A resting order: the fill turns open quantity into position
+    _exposure[_resting[slot].account].position += signedQty;
+    release(id, _resting[slot].quantity - quantity);
+}
+
+void PreTradeRisk::rest(const Order& order, uint64_t quantity)
+{
+    uint32_t slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(_resting.size());
+        _resting.emplace_back();
+    }
+    _resting[slot] = { order.account, order.side,
+                       order.type == OrderType::Stop ? order.stopPrice.raw() : order.price.raw(), quantity };
+    _index.insert(order.id, slot);
+
+    AccountExposure& exposure{ _exposure[order.account] };
+    (order.side == Side::Buy ? exposure.openBuy : exposure.openSell) += quantity;
+    exposure.openNotional = saturatingAdd(exposure.openNotional, notional(_resting[slot].price, quantity));
+}
+
+void PreTradeRisk::release(uint64_t id, uint64_t remaining) noexcept
+{
+    uint32_t slot{ _index.find(id) };
+    if (slot == OrderIndex::npos)
+        return;
+    Resting& resting{ _resting[slot] };
+    if (remaining >= resting.quantity)
+        return;
+
+    uint64_t released{ resting.quantity - remaining };
+    AccountExposure& exposure{ _exposure[resting.account] };
+    (resting.side == Side::Buy ? exposure.openBuy : exposure.openSell) -= released;
+    exposure.openNotional = saturatingSub(exposure.openNotional, notional(resting.price, released));
+    resting.quantity = remaining;
+    if (remaining == 0)
+    {
+        _index.erase(id);
+        _freeSlots.push_back(slot);
+    }
+}
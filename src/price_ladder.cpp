@@ -0,0 +1,120 @@
+#include "../include/price_ladder.hpp"
+#include <algorithm>
+
+PriceLadder::PriceLadder(Side side, std::size_t numLevels, std::size_t windowSize)
+    : _side{ side }, _numLevels{ numLevels },
+        _windowSize{ windowSize == 0 ? numLevels : std::min(windowSize, numLevels) }
+{
+    _window.resize(_windowSize);
+    _occupied.resize(_windowSize);
+    if (_windowSize < _numLevels)
+        _scratch.resize(_windowSize);
+}
+
+void PriceLadder::onFilled(std::size_t index) noexcept
+{
+    if (index - _base < _windowSize)
+        _occupied.set(index - _base);
+    if (_best == npos || isBetter(index, _best))
+        _best = index;
+}
+
+void PriceLadder::onEmptied(std::size_t index) noexcept
+{
+    if (index - _base < _windowSize)
+        _occupied.clear(index - _base);
+    else
+        _overflow.erase(index);
+    if (index == _best)
+        _best = nextAfter(index);
+}
+
+void PriceLadder::copyQuantities(std::size_t from, std::size_t count, uint64_t* out) const
+{
+    std::fill_n(out, count, 0);
+    // Window part: one strided pass over the dense array
+    std::size_t windowEnd{ _base + _windowSize };
+    std::size_t begin{ std::max(from, _base) };
+    std::size_t end{ std::min(from + count, windowEnd) };
+    for (std::size_t i{ begin }; i < end; ++i)
+        out[i - from] = _window[i - _base].quantity;
+    // Overflow levels in range (sparse, usually none near the mid)
+    for (auto it{ _overflow.lower_bound(from) }; it != _overflow.end() && it->first < from + count; ++it)
+        out[it->first - from] = it->second.quantity;
+}
+
+std::size_t PriceLadder::nextAfter(std::size_t index) const noexcept
+{
+    std::size_t fromWindow{ npos };
+    std::size_t fromOverflow{ npos };
+    std::size_t windowEnd{ _base + _windowSize };
+
+    if (_side == Side::Buy)
+    {
+        if (index > _base)
+        {
+            std::size_t found{ _occupied.findPrev(std::min(index, windowEnd) - 1 - _base) };
+            if (found != PriceBitmap::npos)
+                fromWindow = _base + found;
+        }
+        if (!_overflow.empty())
+        {
+            auto it{ _overflow.lower_bound(index) };
+            if (it != _overflow.begin())
+                fromOverflow = std::prev(it)->first;
+        }
+        if (fromWindow == npos)
+            return fromOverflow;
+        if (fromOverflow == npos)
+            return fromWindow;
+        return std::max(fromWindow, fromOverflow);
+    }
+
+    if (index + 1 < windowEnd)
+    {
+        std::size_t found{ _occupied.findNext(std::max(index + 1, _base) - _base) };
+        if (found != PriceBitmap::npos)
+            fromWindow = _base + found;
+    }
+    if (!_overflow.empty())
+    {
+        auto it{ _overflow.upper_bound(index) };
+        if (it != _overflow.end())
+            fromOverflow = it->first;
+    }
+    return std::min(fromWindow, fromOverflow);
+}
+
+void PriceLadder::recenter(std::size_t base)
+{
+    base = std::min(base, _numLevels - _windowSize);
+    if (base == _base)
+        return;
+
+    std::size_t newEnd{ base + _windowSize };
+    std::fill(_scratch.begin(), _scratch.end(), PriceLevel{});
+
+    // Occupied levels of the old window either shift or spill into overflow
+    for (std::size_t i{ _occupied.findFirst() }; i != PriceBitmap::npos; i = _occupied.findNext(i + 1))
+    {
+        std::size_t index{ _base + i };
+        if (index >= base && index < newEnd)
+            _scratch[index - base] = _window[i];
+        else
+            _overflow.emplace(index, _window[i]);
+        _occupied.clear(i);
+    }
+
+    // Overflow levels that fall inside the new window move into it
+    for (auto it{ _overflow.lower_bound(base) }; it != _overflow.end() && it->first < newEnd;)
+    {
+        _scratch[it->first - base] = it->second;
+        it = _overflow.erase(it);
+    }
+
+    _window.swap(_scratch);
+    _base = base;
+    for (std::size_t i{ 0 }; i < _windowSize; ++i)
+        if (!_window[i].empty())
+            _occupied.set(i);
+}
@@ -0,0 +1,186 @@
+// Max-speed replay of a recorded order flow through MatchingEngine.
+//
+//   replay <order-file> [--min P] [--max P] [--tick T] [--window N] [--capacity N]
+//          [--log off|sync|async] [--hash-out FILE] [--expect-hash HEX]
+//
+// The file is a JournalFileHeader and a flat array of JournalRecord (an
+// engine journal or the output of the generator). Prints throughput, the
+// per-input latency distribution and a hash of the trade stream; the hash only depends on
+// the input and the book configuration, so two builds that disagree on it
+// do not match orders the same way.
+
+#include "../include/matching_engine.hpp"
+#include "../include/order_file.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+struct Options
+{
+    std::string path;
+    OrderBookConfig book{ .orderCapacity = 1 << 20, .tradeRetention = 1 << 16 };
+    LogMode log{ LogMode::Off };
+    std::string hashOut;
+    std::string expectHash;
+};
+
+[[noreturn]] void usage(const char* error)
+{
+    std::cerr << "error: " << error << "\n"
+              << "usage: replay <order-file> [--min P] [--max P] [--tick T] [--window N] [--capacity N]\n"
+              << "              [--log off|sync|async] [--hash-out FILE] [--expect-hash HEX]\n";
+    std::exit(2);
+}
+
+Options parse(int argc, char** argv)
+{
+    Options options;
+    for (int i{ 1 }; i < argc; ++i)
+    {
+        std::string arg{ argv[i] };
+        if (arg.rfind("--", 0) != 0)
+        {
+            options.path = arg;
+            continue;
+        }
+        if (i + 1 >= argc)
+            usage("missing option value");
+        std::string value{ argv[++i] };
+        if (arg == "--min")
+            options.book.minPrice = std::stod(value);
+        else if (arg == "--max")
+            options.book.maxPrice = std::stod(value);
+        else if (arg == "--tick")
+            options.book.tickSize = std::stod(value);
+        else if (arg == "--window")
+            options.book.windowLevels = std::stoull(value);
+        else if (arg == "--capacity")
+            options.book.orderCapacity = std::stoull(value);
+        else if (arg == "--log")
+            options.log = value == "sync" ? LogMode::Sync : value == "async" ? LogMode::Async : LogMode::Off;
+        else if (arg == "--hash-out")
+            options.hashOut = value;
+        else if (arg == "--expect-hash")
+            options.expectHash = value;
+        else
+            usage("unknown option");
+    }
+    if (options.path.empty())
+        usage("no order file");
+    return options;
+}
+
+// FNV-1a over the deterministic fields of each trade (not the timestamp)
+class TradeHash
+{
+public:
+    void add(const Trade& trade) noexcept
+    {
+        mix(trade.buy_id);
+        mix(trade.sell_id);
+        mix(static_cast<uint64_t>(trade.price.raw()));
+        mix(trade.quantity);
+    }
+    uint64_t value() const noexcept { return _hash; }
+
+private:
+    void mix(uint64_t word) noexcept
+    {
+        for (int byte{ 0 }; byte < 8; ++byte)
+        {
+            _hash ^= (word >> (byte * 8)) & 0xFF;
+            _hash *= 0x100000001B3ULL;
+        }
+    }
+
+    uint64_t _hash{ 0xCBF29CE484222325ULL };
+};
+
+std::string hex(uint64_t value)
+{
+    char buffer[17]{};
+    auto result{ std::to_chars(buffer, buffer + 16, value, 16) };
+    std::string digits(buffer, result.ptr);
+    return std::string(16 - digits.size(), '0') + digits;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options{ parse(argc, argv) };
+
+    std::unique_ptr<OrderFile> file;
+    try
+    {
+        file = std::make_unique<OrderFile>(options.path);
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << "error: " << error.what() << "\n";
+        return 1;
+    }
+    auto records{ file->records() };
+    MatchingEngine engine(options.log, options.book, 0);
+    const auto& trades{ engine.getOrderBook().getTrades() };
+
+    TscClock::nanosPerTick(); // calibrate before the timed loop
+    LatencyHistogram latency;
+    TradeHash hash;
+    uint64_t tradeCursor{ 0 };
+    uint64_t lostTrades{ 0 };
+
+    auto wallStart{ std::chrono::steady_clock::now() };
+    for (const JournalRecord& record : records)
+    {
+        uint64_t start{ TscClock::now() };
+        engine.apply(record);
+        latency.record(TscClock::now() - start);
+
+        if (tradeCursor < trades.firstSequence())
+            lostTrades += trades.firstSequence() - tradeCursor;
+        trades.poll(tradeCursor, [&hash](uint64_t, const Trade& trade) { hash.add(trade); });
+    }
+    auto wallEnd{ std::chrono::steady_clock::now() };
+    engine.flushLog();
+
+    double seconds{ std::chrono::duration<double>(wallEnd - wallStart).count() };
+    uint64_t tradeCount{ trades.nextSequence() };
+    HistogramSnapshot snap{ latency.snapshot() };
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "inputs       " << records.size() << "\n"
+              << "trades       " << tradeCount << "\n"
+              << "seconds      " << std::setprecision(3) << seconds << std::setprecision(0) << "\n"
+              << "orders/sec   " << static_cast<double>(records.size()) / seconds << "\n"
+              << "trades/sec   " << static_cast<double>(tradeCount) / seconds << "\n"
+              << "latency ns   p50=" << TscClock::toNanos(snap.percentile(50.0))
+              << " p90=" << TscClock::toNanos(snap.percentile(90.0))
+              << " p99=" << TscClock::toNanos(snap.percentile(99.0))
+              << " p99.9=" << TscClock::toNanos(snap.percentile(99.9))
+              << " p99.99=" << TscClock::toNanos(snap.percentile(99.99))
+              << " max=" << TscClock::toNanos(snap.max) << "\n"
+              << "trade_hash   " << hex(hash.value()) << "\n";
+
+    if (lostTrades > 0)
+    {
+        std::cerr << "error: " << lostTrades << " trades fell out of the retention window, hash is incomplete\n";
+        return 1;
+    }
+    if (!options.hashOut.empty())
+        std::ofstream(options.hashOut) << hex(hash.value()) << "\n";
+    if (!options.expectHash.empty() && options.expectHash != hex(hash.value()))
+    {
+        std::cerr << "error: trade hash mismatch, expected " << options.expectHash << "\n";
+        return 1;
+    }
+    return 0;
+}
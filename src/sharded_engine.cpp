@@ -0,0 +1,151 @@
+#include "../include/sharded_engine.hpp"
+#include <algorithm>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ShardedEngine::ShardedEngine(std::size_t numShards, bool pinThreads)
+    : _pinThreads{ pinThreads }
+{
+    if (numShards == 0)
+        throw std::invalid_argument("ShardedEngine needs at least one shard");
+    for (std::size_t i{ 0 }; i < numShards; ++i)
+        _shards.emplace_back(std::make_unique<Shard>());
+}
+
+ShardedEngine::~ShardedEngine()
+{
+    stop();
+}
+
+InstrumentId ShardedEngine::addInstrument(const std::string& symbol, const OrderBookConfig& config)
+{
+    if (_running)
+        throw std::logic_error("Instruments must be added before start()");
+    if (_symbols.count(symbol))
+        throw std::invalid_argument("Duplicate symbol: " + symbol);
+
+    InstrumentId id{ static_cast<InstrumentId>(_placement.size()) };
+    Shard& shard{ *_shards[id % _shards.size()] };
+    _placement.push_back({ static_cast<uint32_t>(id % _shards.size()), static_cast<uint32_t>(shard.books.size()) });
+    shard.books.emplace_back(std::make_unique<OrderBook>(config));
+    _symbols.emplace(symbol, id);
+    return id;
+}
+
+void ShardedEngine::start()
+{
+    if (_running.exchange(true))
+        return;
+    for (std::size_t i{ 0 }; i < _shards.size(); ++i)
+        _shards[i]->thread = std::thread(&ShardedEngine::run, this, i);
+}
+
+void ShardedEngine::stop()
+{
+    if (!_running.exchange(false))
+        return;
+    for (auto& shard : _shards)
+        if (shard->thread.joinable())
+            shard->thread.join();
+}
+
+bool ShardedEngine::route(const Order& order)
+{
+    return _shards[_placement.at(order.instrument).shard]->queue.push(order);
+}
+
+void ShardedEngine::submit(const Order& order)
+{
+    auto& queue{ _shards[_placement.at(order.instrument).shard]->queue };
+    while (!queue.push(order))
+        std::this_thread::yield();
+}
+
+uint64_t ShardedEngine::processedOrders() const noexcept
+{
+    uint64_t total{ 0 };
+    for (const auto& shard : _shards)
+        total += shard->processed.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t ShardedEngine::executedTrades() const noexcept
+{
+    uint64_t total{ 0 };
+    for (const auto& shard : _shards)
+        total += shard->trades.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t ShardedEngine::rejectedOrders() const noexcept
+{
+    uint64_t total{ 0 };
+    for (const auto& shard : _shards)
+        total += shard->rejected.load(std::memory_order_relaxed);
+    return total;
+}
+
+const OrderBook& ShardedEngine::getOrderBook(InstrumentId instrument) const
+{
+    const Placement& placement{ _placement.at(instrument) };
+    return *_shards[placement.shard]->books[placement.slot];
+}
+
+void ShardedEngine::run(std::size_t shardIndex)
+{
+    Shard& shard{ *_shards[shardIndex] };
+
+#ifdef __linux__
+    if (_pinThreads)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(shardIndex % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif
+
+    // Trades are counted locally and published once per batch
+    uint64_t processed{ 0 };
+    uint64_t trades{ 0 };
+    uint64_t rejected{ 0 };
+    for (auto& book : shard.books)
+        book->setOnTradeCallback([&trades](const Trade&) { ++trades; });
+
+    while (true)
+    {
+        // Orders are matched in place inside the ring, no copy into a batch
+        std::span<Order> batch{ shard.queue.claimRead(kBatchSize) };
+        if (batch.empty())
+        {
+            // Producer stores happen before stop(), so an empty queue here is final
+            if (!_running.load(std::memory_order_acquire) && shard.queue.empty())
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (const auto& order : batch)
+        {
+            OrderBook& book{ *shard.books[_placement[order.instrument].slot] };
+            if (book.acceptsOrder(order))
+            {
+                book.processOrder(order);
+                ++processed;
+            }
+            else
+                ++rejected;
+        }
+        shard.queue.commitRead(batch.size());
+
+        shard.processed.store(processed, std::memory_order_relaxed);
+        shard.trades.store(trades, std::memory_order_relaxed);
+        shard.rejected.store(rejected, std::memory_order_relaxed);
+    }
+
+    for (auto& book : shard.books)
+        book->setOnTradeCallback(nullptr);
+}
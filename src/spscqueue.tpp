@@ -1,17 +1,20 @@
 #include "../include/spscqueue.hpp"
-#include <iostream>
+#include <algorithm>
 
 template <typename T, std::size_t N>
 bool SPSCQueue<T, N>::push(const T& item)
 {
     std::size_t head{ _head.load(std::memory_order_relaxed) };
-    std::size_t next_head{ (head + 1) % N };
 
-    if (next_head == _tail.load(std::memory_order_acquire))
-        return false;
+    if (head - _cachedTail == N)
+    {
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        if (head - _cachedTail == N)
+            return false;
+    }
 
-    _buffer[head] = item;
-    _head.store(next_head, std::memory_order_release);
+    _buffer[head & kMask] = item;
+    _head.store(head + 1, std::memory_order_release);
     return true;
 }
 
@@ -19,30 +22,79 @@ template <typename T, std::size_t N>
 bool SPSCQueue<T, N>::pop(T& item)
 {
     std::size_t tail{ _tail.load(std::memory_order_relaxed) };
-    std::size_t next_tail{ (tail + 1) % N };
 
-    if (tail == _head.load(std::memory_order_acquire))
-        return false;
+    if (tail == _cachedHead)
+    {
+        _cachedHead = _head.load(std::memory_order_acquire);
+        if (tail == _cachedHead)
+            return false;
+    }
 
-    item = _buffer[tail];
-    _tail.store(next_tail, std::memory_order_release);
+    item = _buffer[tail & kMask];
+    _tail.store(tail + 1, std::memory_order_release);
     return true;
 }
 
 template <typename T, std::size_t N>
 std::size_t SPSCQueue<T, N>::popBatch(std::vector<T>& out, std::size_t maxSize)
 {
-    std::size_t head{ _head.load(std::memory_order_acquire) };
+    std::size_t total{ 0 };
+
+    // At most two runs: up to the end of the buffer, then from its start
+    for (int run{ 0 }; run < 2 && total < maxSize; ++run)
+    {
+        std::span<T> items{ claimRead(maxSize - total) };
+        if (items.empty())
+            break;
+        out.insert(out.end(), items.begin(), items.end());
+        commitRead(items.size());
+        total += items.size();
+    }
+    return total;
+}
+
+template <typename T, std::size_t N>
+std::span<T> SPSCQueue<T, N>::claimRead(std::size_t maxSize)
+{
     std::size_t tail{ _tail.load(std::memory_order_relaxed) };
 
-    std::size_t available{ (head + N - tail) % N };
-    std::size_t count{ std::min(maxSize, available)};
+    if (tail == _cachedHead)
+    {
+        _cachedHead = _head.load(std::memory_order_acquire);
+        if (tail == _cachedHead)
+            return {};
+    }
+
+    std::size_t offset{ tail & kMask };
+    std::size_t count{ std::min({ maxSize, _cachedHead - tail, N - offset }) };
+    return { _buffer.data() + offset, count };
+}
+
+template <typename T, std::size_t N>
+void SPSCQueue<T, N>::commitRead(std::size_t count)
+{
+    _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template <typename T, std::size_t N>
+std::span<T> SPSCQueue<T, N>::claimWrite(std::size_t maxSize)
+{
+    std::size_t head{ _head.load(std::memory_order_relaxed) };
 
-    for (std::size_t i{ 0 }; i < count; ++i)
+    if (head - _cachedTail == N)
     {
-        out.push_back(_buffer[(tail + i) % N]);
+        _cachedTail = _tail.load(std::memory_order_acquire);
+        if (head - _cachedTail == N)
+            return {};
     }
 
-    _tail.store((tail + count) % N, std::memory_order_release);
-    return count;
-}
\ No newline at end of file
+    std::size_t offset{ head & kMask };
+    std::size_t count{ std::min({ maxSize, N - (head - _cachedTail), N - offset }) };
+    return { _buffer.data() + offset, count };
+}
+
+template <typename T, std::size_t N>
+void SPSCQueue<T, N>::commitWrite(std::size_t count)
+{
+    _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
@@ -0,0 +1,15 @@
+#include "../include/wire_protocol.hpp"
+
+const char* toString(WireError error) noexcept
+{
+    switch (error)
+    {
+        case WireError::None:        return "none";
+        case WireError::Incomplete:  return "incomplete";
+        case WireError::BadLength:   return "bad_length";
+        case WireError::UnknownType: return "unknown_type";
+        case WireError::BadVersion:  return "bad_version";
+        case WireError::BadField:    return "bad_field";
+    }
+    return "unknown";
+}
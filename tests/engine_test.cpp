@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 #include "../include/matching_engine.hpp"
+#include "../include/order_flow.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <tuple>
 
 // --- 1. Базовый сценарий: полное исполнение ---
 TEST(MatchingEngineTest, SimpleFilled) {
@@ -10,7 +16,7 @@ TEST(MatchingEngineTest, SimpleFilled) {
 
     ASSERT_TRUE(!trade.empty());
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "filled");
+    EXPECT_EQ(reports.back().status, ExecStatus::Filled);
 }
 
 // --- 2. Частичное исполнение ---
@@ -20,7 +26,7 @@ TEST(MatchingEngineTest, PartialFill) {
     engine.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 15});
 
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "partially_filled");
+    EXPECT_EQ(reports.back().status, ExecStatus::PartiallyFilled);
 }
 
 // --- 3. Нет сделок (accepted) ---
@@ -29,7 +35,7 @@ TEST(MatchingEngineTest, NoMatchAccepted) {
     engine.processOrder({1, Side::Buy, OrderType::Limit, 100.0, 10});
     const auto& reports = engine.getReports();
 
-    ASSERT_EQ(reports.back().status, "accepted");
+    ASSERT_EQ(reports.back().status, ExecStatus::Accepted);
 }
 
 // --- 4. Несколько сделок подряд ---
@@ -52,7 +58,7 @@ TEST(MatchingEngineTest, MarketBuyOrderExecutesImmediately) {
 
     ASSERT_TRUE(!trade.empty());
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "filled");
+    EXPECT_EQ(reports.back().status, ExecStatus::Filled);
 }
 
 // --- 6. Рыночный ордер без продавцов ---
@@ -62,7 +68,7 @@ TEST(MatchingEngineTest, MarketOrderWithoutCounterparty) {
     auto trade = engine.getOrderBook().getTrades();
     EXPECT_FALSE(!trade.empty());
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "accepted"); // не было сделок
+    EXPECT_EQ(reports.back().status, ExecStatus::Accepted); // не было сделок
 }
 
 // --- 7. Последовательность: Limit + Market ---
@@ -75,7 +81,7 @@ TEST(MatchingEngineTest, LimitThenMarketOrder) {
 
     ASSERT_TRUE(!trade.empty());
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "filled");
+    EXPECT_EQ(reports.back().status, ExecStatus::Filled);
 }
 
 // --- 8. Проверка репортов ---
@@ -86,8 +92,8 @@ TEST(MatchingEngineTest, ExecutionReportLogging) {
     const auto& reports = engine.getReports();
 
     ASSERT_GE(reports.size(), 2);
-    EXPECT_EQ(reports[0].status, "accepted");
-    EXPECT_EQ(reports.back().status, "filled");
+    EXPECT_EQ(reports[0].status, ExecStatus::Accepted);
+    EXPECT_EQ(reports.back().status, ExecStatus::Filled);
 }
 
 // --- 9. Несколько уровней цен в одном тесте ---
@@ -101,5 +107,273 @@ TEST(MatchingEngineTest, MultiLevelMarketBuy) {
 
     ASSERT_TRUE(!trade.empty());
     const auto& reports = engine.getReports();
-    EXPECT_EQ(reports.back().status, "filled");
+    EXPECT_EQ(reports.back().status, ExecStatus::Filled);
+}
+
+// --- 10. Отчёты об отмене, уменьшении и замене ---
+TEST(MatchingEngineTest, CancelReduceReplaceReports) {
+    MatchingEngine engine;
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 10});
+    engine.processOrder({2, Side::Sell, OrderType::Limit, 101.0, 10});
+
+    engine.reduceOrder(1, 6);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Reduced);
+    EXPECT_EQ(engine.getReports().back().quantity, 6);
+
+    engine.cancelOrder(1);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Canceled);
+    engine.cancelOrder(1);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::CancelRejected);
+
+    engine.replaceOrder(2, {3, Side::Sell, OrderType::Limit, 102.0, 5});
+    const auto& reports = engine.getReports();
+    EXPECT_EQ(reports[reports.size() - 2].status, ExecStatus::Replaced);
+    EXPECT_EQ(reports.back().id, 3);
+    EXPECT_EQ(reports.back().status, ExecStatus::Accepted);
+    EXPECT_EQ(engine.getOrderBook().findOrder(2), nullptr);
+    ASSERT_NE(engine.getOrderBook().findOrder(3), nullptr);
+}
+
+// --- 11. Исполненный объём, остаток и средняя цена ---
+TEST(MatchingEngineTest, ReportCarriesFillDetails) {
+    MatchingEngine engine(LogMode::Off);
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 99.0, 10});
+    engine.processOrder({2, Side::Sell, OrderType::Limit, 100.0, 10});
+    engine.processOrder({3, Side::Sell, OrderType::Limit, 101.0, 10});
+    engine.processOrder({4, Side::Buy, OrderType::Market, 0.0, 25});
+
+    const auto& sweep = engine.getReports().back();
+    EXPECT_EQ(sweep.filledQty, 25);
+    EXPECT_EQ(sweep.leavesQty, 0);
+    EXPECT_EQ(sweep.avgFillPrice, 99.8); // (99*10 + 100*10 + 101*5) / 25
+
+    engine.processOrder({5, Side::Buy, OrderType::Limit, 101.0, 8});
+    const auto& partial = engine.getReports().back();
+    EXPECT_EQ(partial.status, ExecStatus::PartiallyFilled);
+    EXPECT_EQ(partial.filledQty, 5);
+    EXPECT_EQ(partial.leavesQty, 3);
+    EXPECT_EQ(partial.avgFillPrice, 101.0);
+}
+
+// Приёмник без аллокаций: отчёты копируются в фиксированный массив
+struct FixedReportSink {
+    std::array<ExecutionReport, 8> reports{};
+    size_t count = 0;
+    void publish(const ExecutionReport& report) { reports[count++ % reports.size()] = report; }
+};
+
+// --- 12. Отчёты идут в пользовательский приёмник ---
+TEST(MatchingEngineTest, CustomReportSink) {
+    BasicMatchingEngine<FixedReportSink> engine(LogMode::Off);
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 10});
+    engine.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 4});
+    engine.cancelOrder(1);
+
+    const auto& sink = engine.getReports();
+    ASSERT_EQ(sink.count, 3);
+    EXPECT_EQ(sink.reports[0].status, ExecStatus::Accepted);
+    EXPECT_EQ(sink.reports[1].status, ExecStatus::Filled);
+    EXPECT_EQ(sink.reports[2].status, ExecStatus::Canceled);
+    EXPECT_EQ(sink.reports[2].quantity, 6);
+}
+
+// Приёмник с пакетной публикацией: считает вызовы
+struct BatchCountingSink
+{
+    std::vector<ExecutionReport> reports;
+    size_t batches = 0;
+    void publish(const ExecutionReport& report) { reports.push_back(report); }
+    void publish(std::span<const ExecutionReport> batch) {
+        reports.insert(reports.end(), batch.begin(), batch.end());
+        ++batches;
+    }
+};
+
+static auto reportFields(const ExecutionReport& r) {
+    return std::make_tuple(r.id, r.status, r.price.raw(), r.quantity, r.filledQty, r.leavesQty, r.avgFillPrice.raw());
+}
+
+// --- 13. Пакетная обработка даёт те же сделки, отчёты, стакан и метрики ---
+TEST(MatchingEngineTest, BatchMatchesPerOrderPath) {
+    OrderFlowConfig flow;
+    flow.seed = 11;
+    flow.limitPercent = 80;
+    flow.marketPercent = 20;
+    flow.cancelPercent = 0;
+    flow.aggressivePercent = 30;
+    OrderFlowGenerator generator(flow);
+    std::vector<Order> orders;
+    for (int i = 0; i < 20000; ++i)
+        orders.push_back(generator.next().toOrder());
+    // Среди них отклоняемые на входе: нулевой объём и цена вне сетки
+    for (size_t i = 0; i < orders.size(); i += 97)
+        orders[i].quantity = 0;
+    for (size_t i = 50; i < orders.size(); i += 101) {
+        orders[i].type = OrderType::Limit;
+        orders[i].price = Price::fromRaw(orders[i].price.raw() + 1);
+    }
+    OrderBook grid;
+    auto rejected = static_cast<size_t>(std::count_if(orders.begin(), orders.end(),
+                                                      [&](const Order& o) { return !grid.acceptsOrder(o); }));
+    ASSERT_GT(rejected, 300u);
+
+    BasicMatchingEngine<BatchCountingSink> single(LogMode::Off, OrderBookConfig{ .orderCapacity = 1 << 15 });
+    BasicMatchingEngine<BatchCountingSink> batched(LogMode::Off, OrderBookConfig{ .orderCapacity = 1 << 15 });
+    for (const auto& order : orders)
+        single.processOrder(order);
+    // Пакеты разного размера, включая 1 и больше 1000
+    size_t position = 0, batches = 0;
+    for (size_t size : { 1, 7, 64, 1000, 3, 1024 }) {
+        for (; position + size <= orders.size() && batches < 5 * (size + 1); ++batches) {
+            batched.processBatchOrders(std::span<const Order>(orders).subspan(position, size));
+            position += size;
+        }
+    }
+    batched.processBatchOrders(std::span<const Order>(orders).subspan(position));
+    ++batches;
+
+    const auto& a = single.getOrderBook().getTrades();
+    const auto& b = batched.getOrderBook().getTrades();
+    ASSERT_GT(a.nextSequence(), 1000u);
+    ASSERT_EQ(a.nextSequence(), b.nextSequence());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].buy_id, b[i].buy_id);
+        EXPECT_EQ(a[i].sell_id, b[i].sell_id);
+        EXPECT_EQ(a[i].price, b[i].price);
+        EXPECT_EQ(a[i].quantity, b[i].quantity);
+    }
+
+    const auto& ra = single.getReports().reports;
+    const auto& rb = batched.getReports().reports;
+    ASSERT_EQ(ra.size(), rb.size());
+    for (size_t i = 0; i < ra.size(); ++i)
+        EXPECT_EQ(reportFields(ra[i]), reportFields(rb[i])) << i;
+    EXPECT_EQ(batched.getReports().batches, batches);
+
+    for (Side side : { Side::Buy, Side::Sell }) {
+        std::vector<std::tuple<int64_t, uint64_t, size_t>> la, lb;
+        single.getOrderBook().forEachLevel(side, SIZE_MAX, [&](Price p, uint64_t q, size_t n) { la.emplace_back(p.raw(), q, n); });
+        batched.getOrderBook().forEachLevel(side, SIZE_MAX, [&](Price p, uint64_t q, size_t n) { lb.emplace_back(p.raw(), q, n); });
+        EXPECT_EQ(la, lb);
+    }
+    EXPECT_EQ(batched.getMetrics().processed_orders.load(), orders.size() - rejected);
+    EXPECT_EQ(batched.getMetrics().processed_orders.load(), single.getMetrics().processed_orders.load());
+    EXPECT_EQ(batched.getMetrics().executed_trades.load(), b.nextSequence());
+    EXPECT_EQ(batched.getMetrics().executed_trades.load(), single.getMetrics().executed_trades.load());
+}
+
+// --- 14. Аукцион: рыночные заявки отклоняются, uncross исполняет пересечение ---
+TEST(MatchingEngineTest, AuctionRejectsMarketOrders) {
+    MatchingEngine engine(LogMode::Off);
+    engine.startAuction();
+    engine.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 10});
+    engine.processOrder({2, Side::Sell, OrderType::Limit, 100.0, 4});
+    engine.processOrder({3, Side::Buy, OrderType::Market, 0.0, 5});
+
+    const auto& reports = engine.getReports();
+    ASSERT_EQ(reports.size(), 3);
+    EXPECT_EQ(reports[0].status, ExecStatus::Accepted);
+    EXPECT_EQ(reports[1].status, ExecStatus::Accepted);
+    EXPECT_EQ(reports[2].status, ExecStatus::Rejected);
+
+    AuctionResult result = engine.uncross();
+    EXPECT_EQ(result.volume, 4);
+    EXPECT_EQ(engine.getMetrics().executed_trades.load(), 1);
+    EXPECT_EQ(engine.getOrderBook().findOrder(1)->quantity, 6);
+}
+
+// --- 15. Стоп-заявка: Accepted при постановке, отчёт о срабатывании после сделки ---
+TEST(MatchingEngineTest, StopActivationIsReported) {
+    MatchingEngine engine(LogMode::Off);
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 5});
+    Order stop{10, Side::Buy, OrderType::Stop, 0.0, 3};
+    stop.stopPrice = 100.0;
+    engine.processOrder(stop);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Accepted);
+    EXPECT_EQ(engine.getReports().back().leavesQty, 3);
+
+    engine.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 2});
+    const auto& reports = engine.getReports();
+    ASSERT_GE(reports.size(), 2);
+    const auto& own = reports[reports.size() - 2];
+    EXPECT_EQ(own.id, 2);
+    EXPECT_EQ(own.status, ExecStatus::Filled);
+    EXPECT_EQ(own.filledQty, 2);
+    const auto& fired = reports.back();
+    EXPECT_EQ(fired.id, 10);
+    EXPECT_EQ(fired.status, ExecStatus::Filled);
+    EXPECT_EQ(fired.filledQty, 3);
+    EXPECT_EQ(fired.avgFillPrice, Price{ 100.0 });
+    EXPECT_EQ(engine.getMetrics().executed_trades.load(), 2);
+}
+
+// --- 16. Заявки вне сетки цен, вне диапазона и с нулевым объёмом отклоняются на входе ---
+TEST(MatchingEngineTest, OrdersOffTheGridAreRejected) {
+    MatchingEngine engine(LogMode::Off);
+    engine.processOrder({1, Side::Buy, OrderType::Limit, 100.0, 10});
+
+    Order offTick{2, Side::Buy, OrderType::Limit, 0.0, 1};
+    offTick.price = Price::fromRaw(Price{ 100.0 }.raw() + 1);
+    Order offTrigger{6, Side::Sell, OrderType::Stop, 0.0, 1};
+    offTrigger.stopPrice = Price{ 99.995 };
+    Order offStopLimit{7, Side::Sell, OrderType::StopLimit, 99.0, 1};
+    offStopLimit.stopPrice = Price{ -1.0 };
+    for (const Order& order : { offTick,
+                                Order{3, Side::Sell, OrderType::Limit, -5.0, 1},
+                                Order{4, Side::Sell, OrderType::Limit, 10000.01, 1},
+                                Order{5, Side::Sell, OrderType::Limit, 100.0, 0},
+                                offTrigger, offStopLimit }) {
+        engine.processOrder(order);
+        EXPECT_EQ(engine.getReports().back().id, order.id);
+        EXPECT_EQ(engine.getReports().back().status, ExecStatus::Rejected);
+        EXPECT_EQ(engine.getOrderBook().findOrder(order.id), nullptr);
+    }
+    EXPECT_EQ(engine.getOrderBook().getTrades().nextSequence(), 0u);
+
+    // Рыночной заявке цена не нужна
+    engine.processOrder({8, Side::Sell, OrderType::Market, 0.0, 4});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Filled);
+
+    // Неверная замена не снимает исходную заявку
+    engine.replaceOrder(1, {9, Side::Buy, OrderType::Limit, 100.001, 6});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::ReplaceRejected);
+    ASSERT_NE(engine.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(engine.getOrderBook().findOrder(1)->quantity, 6);
+
+    // Пакетный путь проверяет так же
+    std::array<Order, 2> batch{ Order{10, Side::Buy, OrderType::Limit, 99.0, 0}, Order{11, Side::Buy, OrderType::Limit, 99.0, 1} };
+    engine.processBatchOrders(batch);
+    const auto& reports = engine.getReports();
+    EXPECT_EQ(reports[reports.size() - 2].status, ExecStatus::Rejected);
+    EXPECT_EQ(reports.back().status, ExecStatus::Accepted);
+    EXPECT_EQ(engine.getOrderBook().findOrder(10), nullptr);
+
+    // Объём, при котором maxPrice * объём не помещается в int64: продажа по 1.0
+    // может исполниться по 10000.0, сумма сделок переполнила бы оборот
+    engine.processOrder({12, Side::Sell, OrderType::Limit, 1.0, 1'000'000'000});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Rejected);
+    engine.processOrder({13, Side::Sell, OrderType::Market, 0.0, uint64_t{ 1 } << 63});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Rejected);
+    engine.processOrder({14, Side::Sell, OrderType::Limit, 9999.0, 900'000'000});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Accepted);
+}
+
+// --- 17. Средняя цена исполнения: округление и оборот у предела int64 ---
+TEST(MatchingEngineTest, AverageFillPriceNearTheNotionalLimit) {
+    EXPECT_EQ(averagePrice(7, 2), Price::fromRaw(4)); // 3.5 округляется вверх
+    EXPECT_EQ(averagePrice(5, 3), Price::fromRaw(2));
+    EXPECT_EQ(averagePrice(4, 3), Price::fromRaw(1));
+    EXPECT_EQ(averagePrice(100, 0), Price{ 0.0 });
+    // Насыщенный оборот: деление без переполнения
+    constexpr int64_t kMax{ std::numeric_limits<int64_t>::max() };
+    EXPECT_EQ(averagePrice(kMax, 2), Price::fromRaw(kMax / 2 + 1));
+    EXPECT_EQ(averagePrice(kMax, 1), Price::fromRaw(kMax));
+
+    // Наибольший объём, который движок принимает по максимальной цене
+    MatchingEngine engine(LogMode::Off);
+    uint64_t largest{ static_cast<uint64_t>(kMax / Price{ 10000.0 }.raw()) };
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 10000.0, largest});
+    engine.processOrder({2, Side::Buy, OrderType::Market, 0.0, largest});
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Filled);
+    EXPECT_EQ(engine.getReports().back().avgFillPrice, Price{ 10000.0 });
 }
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../include/async_logger.hpp"
+#include "../include/logger.hpp"
+#include <fstream>
+#include <regex>
+
+// Тот же шаблон, что разбирает scripts/analyze_trades.py
+static const std::regex kTradeLine{ R"(\[(.*?)\]\s+TRADE\s+(\d+)->(\d+)\s+qty=(\d+)\s+price=([\d.]+))" };
+
+static std::vector<std::string> readLines(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);)
+        lines.push_back(line);
+    return lines;
+}
+
+// --- 1. Формат строк совпадает с синхронным логгером ---
+TEST(AsyncLoggerTest, WritesAnalyzerCompatibleLines) {
+    auto path = Logger::resolvePath("async_logger_format_test.log");
+    std::filesystem::remove(path);
+    {
+        AsyncTradeLogger logger("async_logger_format_test.log");
+        logger.log({7, 9, 99.99, 15, std::chrono::steady_clock::now()});
+        logger.log({8, 10, 100.0, 1, std::chrono::steady_clock::now()});
+        logger.flush();
+    }
+
+    auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 2);
+    std::smatch m;
+    ASSERT_TRUE(std::regex_search(lines[0], m, kTradeLine)) << lines[0];
+    EXPECT_EQ(m[2], "7");
+    EXPECT_EQ(m[3], "9");
+    EXPECT_EQ(m[4], "15");
+    EXPECT_EQ(m[5], "99.99");
+    ASSERT_TRUE(std::regex_search(lines[1], m, kTradeLine)) << lines[1];
+    EXPECT_EQ(m[5], "100");
+    std::filesystem::remove(path);
+}
+
+// --- 2. Политика Drop: каждая запись либо записана, либо посчитана как потерянная ---
+TEST(AsyncLoggerTest, DropPolicyCountsDroppedRecords) {
+    auto path = Logger::resolvePath("async_logger_drop_test.log");
+    std::filesystem::remove(path);
+    constexpr uint64_t kRecords{ 100'000 };
+    uint64_t accepted{ 0 };
+    {
+        AsyncTradeLogger logger("async_logger_drop_test.log", OverflowPolicy::Drop);
+        for (uint64_t i = 0; i < kRecords; ++i)
+            accepted += logger.log({i, i + 1, 100.0, 1, std::chrono::steady_clock::now()});
+        logger.flush();
+        EXPECT_EQ(logger.written(), accepted);
+        EXPECT_EQ(logger.written() + logger.dropped(), kRecords);
+    }
+    EXPECT_EQ(readLines(path).size(), accepted);
+    std::filesystem::remove(path);
+}
+
+// --- 3. Политика Block: ничего не теряется ---
+TEST(AsyncLoggerTest, BlockPolicyNeverDrops) {
+    auto path = Logger::resolvePath("async_logger_block_test.log");
+    std::filesystem::remove(path);
+    constexpr uint64_t kRecords{ 50'000 };
+    {
+        AsyncTradeLogger logger("async_logger_block_test.log", OverflowPolicy::Block);
+        for (uint64_t i = 0; i < kRecords; ++i)
+            EXPECT_TRUE(logger.log({i, i + 1, 100.0, 1, std::chrono::steady_clock::now()}));
+        logger.flush();
+        EXPECT_EQ(logger.dropped(), 0);
+        EXPECT_EQ(logger.written(), kRecords);
+    }
+    EXPECT_EQ(readLines(path).size(), kRecords);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "../include/market_data.hpp"
+#include <map>
+#include <thread>
+
+// Глубина стакана из book.forEachLevel: цена -> объём
+static std::map<int64_t, uint64_t> bookDepth(const OrderBook& book, Side side) {
+    std::map<int64_t, uint64_t> depth;
+    book.forEachLevel(side, SIZE_MAX, [&](Price price, uint64_t quantity, size_t) {
+        depth[price.raw()] = quantity;
+    });
+    return depth;
+}
+
+// Стакан, восстановленный на стороне получателя из инкрементов
+struct L2Mirror {
+    std::map<int64_t, uint64_t> bids;
+    std::map<int64_t, uint64_t> asks;
+    uint64_t lastSequence = 0;
+
+    void apply(const LevelUpdate& update) {
+        auto& levels = update.side == Side::Buy ? bids : asks;
+        if (update.quantity == 0)
+            levels.erase(update.price.raw());
+        else
+            levels[update.price.raw()] = update.quantity;
+        lastSequence = update.sequence;
+    }
+};
+
+// --- 1. Агрегированный объём уровня поддерживается инкрементально ---
+TEST(MarketDataTest, LevelQuantityTracksBook) {
+    OrderBook book;
+    book.processOrder({1, Side::Sell, OrderType::Limit, 101.0, 10});
+    book.processOrder({2, Side::Sell, OrderType::Limit, 101.0, 5});
+    book.processOrder({3, Side::Sell, OrderType::Limit, 102.0, 7});
+    book.processOrder({4, Side::Buy, OrderType::Limit, 101.0, 4}); // частичное исполнение #1
+    EXPECT_EQ(bookDepth(book, Side::Sell)[Price{ 101.0 }.raw()], 11);
+
+    book.reduceOrder(2, 1);
+    EXPECT_EQ(bookDepth(book, Side::Sell)[Price{ 101.0 }.raw()], 7);
+
+    book.processOrder({5, Side::Buy, OrderType::Market, 0.0, 9}); // снимает 101.0 целиком, 2 с 102.0
+    auto asks = bookDepth(book, Side::Sell);
+    ASSERT_EQ(asks.size(), 1);
+    EXPECT_EQ(asks[Price{ 102.0 }.raw()], 5);
+
+    book.cancelOrder(3);
+    EXPECT_TRUE(bookDepth(book, Side::Sell).empty());
+}
+
+// --- 2. Инкременты воспроизводят стакан ---
+TEST(MarketDataTest, IncrementalUpdatesRebuildBook) {
+    OrderBook book;
+    MarketDataPublisher publisher(book, 16, 0);
+    L2Mirror mirror;
+
+    book.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+    book.processOrder({2, Side::Buy, OrderType::Limit, 99.0, 3});
+    book.processOrder({3, Side::Sell, OrderType::Limit, 100.0, 8});
+    book.processOrder({4, Side::Sell, OrderType::Market, 0.0, 12});
+    book.reduceOrder(3, 2);
+
+    std::vector<LevelUpdate> updates;
+    publisher.poll([&](const LevelUpdate& update) { updates.push_back(update); mirror.apply(update); });
+    ASSERT_FALSE(updates.empty());
+    for (size_t i = 0; i < updates.size(); ++i)
+        EXPECT_EQ(updates[i].sequence, i + 1);
+
+    EXPECT_EQ(mirror.bids, bookDepth(book, Side::Buy));
+    EXPECT_EQ(mirror.asks, bookDepth(book, Side::Sell));
+    EXPECT_EQ(mirror.bids[Price{ 99.0 }.raw()], 1);
+}
+
+// --- 3. Медленный получатель: обновления склеиваются по уровню ---
+TEST(MarketDataTest, SlowConsumerGetsConflatedUpdates) {
+    OrderBook book;
+    MarketDataPublisher publisher(book, 16, 0);
+
+    // Заполняем кольцо и продолжаем менять два уровня, никто не читает
+    for (uint64_t i = 0; i < MarketDataPublisher::kQueueSize + 1000; ++i)
+        book.processOrder({i, (i % 2 == 0) ? Side::Buy : Side::Sell, OrderType::Limit, (i % 2 == 0) ? 99.0 : 101.0, 1});
+
+    EXPECT_EQ(publisher.pendingLevels(), 2);
+    EXPECT_EQ(publisher.conflated(), 998);
+
+    L2Mirror mirror;
+    publisher.poll([&](const LevelUpdate& update) { mirror.apply(update); });
+    publisher.flush();
+    EXPECT_EQ(publisher.pendingLevels(), 0);
+    publisher.poll([&](const LevelUpdate& update) { mirror.apply(update); });
+
+    EXPECT_EQ(mirror.bids, bookDepth(book, Side::Buy));
+    EXPECT_EQ(mirror.asks, bookDepth(book, Side::Sell));
+    EXPECT_EQ(mirror.lastSequence, MarketDataPublisher::kQueueSize + 2);
+}
+
+// --- 4. Снимок + последующие инкременты дают текущий стакан ---
+TEST(MarketDataTest, SnapshotPlusUpdatesFromOtherThread) {
+    OrderBook book(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 1000.0, .tickSize = 0.01, .orderCapacity = 4096 });
+    MarketDataPublisher publisher(book, 1024, 64);
+    std::atomic<bool> done{ false };
+
+    DepthSnapshot snapshot;
+    std::vector<LevelUpdate> updates;
+    std::thread consumer([&]() {
+        while (!done.load(std::memory_order_acquire)) {
+            if (publisher.poll([&](const LevelUpdate& update) { updates.push_back(update); }) == 0)
+                std::this_thread::yield();
+            if (snapshot.sequence == 0)
+                publisher.readSnapshot(snapshot);
+        }
+        publisher.poll([&](const LevelUpdate& update) { updates.push_back(update); });
+    });
+
+    uint64_t seed{ 42 };
+    auto next = [&seed]() { seed = seed * 6364136223846793005ULL + 1442695040888963407ULL; return seed >> 33; };
+    for (uint64_t id = 0; id < 20'000; ++id) {
+        Side side{ next() % 2 == 0 ? Side::Buy : Side::Sell };
+        int64_t ticks{ 50'000 + (side == Side::Buy ? -1 : 1) * static_cast<int64_t>(next() % 200) - 20 };
+        book.processOrder({id, side, OrderType::Limit, Price::fromRaw(ticks * 10'000), 1 + next() % 10});
+        if (id % 3 == 0)
+            book.cancelOrder(id / 2);
+        if (id % 256 == 0)
+            publisher.flush();
+    }
+    while (publisher.pendingLevels() > 0) {
+        publisher.flush();
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    ASSERT_GT(snapshot.sequence, 0);
+    L2Mirror mirror;
+    for (const auto& level : snapshot.bids)
+        mirror.bids[level.price.raw()] = level.quantity;
+    for (const auto& level : snapshot.asks)
+        mirror.asks[level.price.raw()] = level.quantity;
+    for (const auto& update : updates)
+        if (update.sequence > snapshot.sequence)
+            mirror.apply(update);
+
+    EXPECT_EQ(mirror.bids, bookDepth(book, Side::Buy));
+    EXPECT_EQ(mirror.asks, bookDepth(book, Side::Sell));
+}
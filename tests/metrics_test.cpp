@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "../include/latency_histogram.hpp"
+#include "../include/matching_engine.hpp"
+#include <thread>
+
+// --- 1. Перцентили с точностью до ширины бакета (< 1/32) ---
+TEST(LatencyHistogramTest, PercentilesWithinBucketPrecision) {
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 10'000; ++v)
+        histogram.record(v);
+
+    HistogramSnapshot snap{ histogram.snapshot() };
+    EXPECT_EQ(snap.count, 10'000);
+    EXPECT_EQ(snap.max, 10'000);
+    EXPECT_NEAR(static_cast<double>(snap.percentile(50.0)), 5'000.0, 5'000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(snap.percentile(99.0)), 9'900.0, 9'900.0 / 32);
+    EXPECT_NEAR(static_cast<double>(snap.percentile(99.9)), 9'990.0, 9'990.0 / 32);
+    EXPECT_EQ(snap.percentile(100.0), 10'000);
+}
+
+// --- 2. Маленькие значения хранятся точно, хвост виден отдельно от среднего ---
+TEST(LatencyHistogramTest, TailIsNotHiddenByAverage) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 990; ++i)
+        histogram.record(20);
+    for (int i = 0; i < 10; ++i)
+        histogram.record(1'000'000);
+
+    HistogramSnapshot snap{ histogram.snapshot() };
+    EXPECT_EQ(snap.percentile(50.0), 20);
+    EXPECT_EQ(snap.percentile(99.0), 20);
+    EXPECT_GE(snap.percentile(99.9), 1'000'000 - 1'000'000 / 32);
+    EXPECT_EQ(snap.max, 1'000'000);
+}
+
+// --- 3. reset() не останавливает запись, снимок содержит только новые значения ---
+TEST(LatencyHistogramTest, SnapshotAndReset) {
+    LatencyHistogram histogram;
+    histogram.record(100);
+    histogram.record(200);
+    HistogramSnapshot first{ histogram.snapshotAndReset() };
+    EXPECT_EQ(first.count, 2);
+
+    histogram.record(7);
+    HistogramSnapshot second{ histogram.snapshot() };
+    EXPECT_EQ(second.count, 1);
+    EXPECT_EQ(second.max, 7);
+    EXPECT_EQ(second.percentile(50.0), 7);
+    EXPECT_EQ(histogram.totalCount(), 3);
+}
+
+// --- 4. Метрики движка раскладываются по классам ордеров и читаются из другого потока ---
+TEST(MatchingEngineMetricsTest, SeparateHistogramsPerOrderClass) {
+    MatchingEngine engine(LogMode::Off);
+    std::atomic<bool> done{ false };
+    std::thread reader([&]() {
+        while (!done.load())
+            (void)engine.getMetrics().add_latency.snapshot();
+    });
+
+    engine.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 10}); // add
+    engine.processOrder({2, Side::Sell, OrderType::Limit, 101.0, 10}); // add
+    engine.processOrder({3, Side::Buy, OrderType::Limit, 100.0, 5});   // match
+    engine.processOrder({4, Side::Buy, OrderType::Market, 0.0, 10});   // sweep
+    done = true;
+    reader.join();
+
+    const Metrics& metrics = engine.getMetrics();
+    EXPECT_EQ(metrics.processed_orders.load(), 4);
+    EXPECT_EQ(metrics.executed_trades.load(), 3);
+    EXPECT_EQ(metrics.add_latency.snapshot().count, 2);
+    EXPECT_EQ(metrics.match_latency.snapshot().count, 1);
+    EXPECT_EQ(metrics.sweep_latency.snapshot().count, 1);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../include/mpscqueue.hpp"
+#include <thread>
+#include <vector>
+
+// --- 1. Используются все N слотов, кольцо переходит через конец ---
+TEST(MPSCQueueTest, FullCapacityAndWraparound) {
+    MPSCQueue<int, 8> queue;
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 8; ++i)
+            EXPECT_TRUE(queue.push(lap * 10 + i));
+        EXPECT_FALSE(queue.push(-1));
+        EXPECT_EQ(queue.size(), 8);
+
+        int value{ -1 };
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, lap * 10 + i);
+        }
+        EXPECT_FALSE(queue.pop(value));
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+// --- 2. Пакетное чтение: обработка на месте и ограничение размера ---
+TEST(MPSCQueueTest, ConsumeDrainsInBatches) {
+    MPSCQueue<int, 16> queue;
+    for (int i = 0; i < 10; ++i)
+        queue.push(i);
+
+    std::vector<int> seen;
+    EXPECT_EQ(queue.consume([&](int& value) { seen.push_back(value); }, 4), 4);
+    EXPECT_EQ(seen, (std::vector<int>{ 0, 1, 2, 3 }));
+
+    std::vector<int> rest;
+    EXPECT_EQ(queue.popBatch(rest, 64), 6);
+    EXPECT_EQ(rest, (std::vector<int>{ 4, 5, 6, 7, 8, 9 }));
+    EXPECT_EQ(queue.consume([](int&) {}, 64), 0);
+}
+
+// --- 3. Несколько производителей: ничего не теряется, порядок каждого сохранён ---
+TEST(MPSCQueueTest, MultipleProducersKeepPerProducerOrder) {
+    constexpr uint64_t kProducers{ 4 };
+    constexpr uint64_t kPerProducer{ 50'000 };
+    MPSCQueue<uint64_t, 256> queue;
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (uint64_t i = 0; i < kPerProducer; ++i)
+                while (!queue.push((p << 32) | i))
+                    std::this_thread::yield();
+        });
+    }
+
+    std::vector<uint64_t> next(kProducers, 0);
+    uint64_t received{ 0 };
+    while (received < kProducers * kPerProducer) {
+        std::size_t count{ queue.consume([&](uint64_t& value) {
+            uint64_t producer{ value >> 32 };
+            ASSERT_LT(producer, kProducers);
+            EXPECT_EQ(value & 0xFFFFFFFF, next[producer]);
+            ++next[producer];
+        }, 64) };
+        if (count == 0)
+            std::this_thread::yield();
+        received += count;
+    }
+    for (auto& thread : producers)
+        thread.join();
+
+    for (uint64_t p = 0; p < kProducers; ++p)
+        EXPECT_EQ(next[p], kPerProducer);
+    EXPECT_TRUE(queue.empty());
+}
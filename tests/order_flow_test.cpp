@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../include/matching_engine.hpp"
+#include "../include/order_file.hpp"
+#include "../include/order_flow.hpp"
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <unordered_set>
+
+static std::vector<JournalRecord> generate(const OrderFlowConfig& config, std::size_t count) {
+    OrderFlowGenerator generator(config);
+    std::vector<JournalRecord> records(count);
+    generator.generate(records.data(), count);
+    return records;
+}
+
+static bool sameRecords(const std::vector<JournalRecord>& a, const std::vector<JournalRecord>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(JournalRecord)) == 0;
+}
+
+// --- 1. Один и тот же seed даёт тот же поток, другой seed — другой ---
+TEST(OrderFlowTest, SeedIsReproducible) {
+    OrderFlowConfig config;
+    config.seed = 7;
+    auto first = generate(config, 10000);
+    EXPECT_TRUE(sameRecords(first, generate(config, 10000)));
+
+    config.seed = 8;
+    EXPECT_FALSE(sameRecords(first, generate(config, 10000)));
+}
+
+// --- 2. Доли лимитных, рыночных и отмен соответствуют конфигурации ---
+TEST(OrderFlowTest, InputMixFollowsConfig) {
+    OrderFlowConfig config;
+    config.limitPercent = 50;
+    config.marketPercent = 20;
+    config.cancelPercent = 30;
+    auto records = generate(config, 200000);
+
+    std::size_t limits = 0, markets = 0, cancels = 0;
+    for (const auto& record : records) {
+        if (record.kind == JournalKind::Cancel)
+            ++cancels;
+        else if (static_cast<OrderType>(record.type) == OrderType::Market)
+            ++markets;
+        else
+            ++limits;
+    }
+    EXPECT_NEAR(limits / 2000.0, 50.0, 1.0);
+    EXPECT_NEAR(markets / 2000.0, 20.0, 1.0);
+    EXPECT_NEAR(cancels / 2000.0, 30.0, 1.0);
+}
+
+// --- 3. Цены на сетке шага и внутри диапазона, объёмы в пределах ---
+TEST(OrderFlowTest, PricesAndSizesStayInBounds) {
+    OrderFlowConfig config;
+    config.startPrice = 10.0;
+    config.minPrice = 9.9;
+    config.maxPrice = 10.1;
+    config.tickSize = 0.05;
+    config.tickRate = 1e7; // блуждание упирается в границы
+    config.meanDepthTicks = 50.0;
+    config.maxSize = 40;
+
+    const int64_t tick = Price{ 0.05 }.raw();
+    for (const auto& record : generate(config, 100000)) {
+        if (record.kind == JournalKind::Cancel)
+            continue;
+        EXPECT_GE(record.quantity, 1u);
+        EXPECT_LE(record.quantity, 40u);
+        if (static_cast<OrderType>(record.type) == OrderType::Market)
+            continue;
+        EXPECT_EQ(record.price_raw % tick, 0);
+        EXPECT_GE(record.price_raw, Price{ 9.9 }.raw());
+        EXPECT_LE(record.price_raw, Price{ 10.1 }.raw());
+    }
+}
+
+// --- 4. Отмены ссылаются только на уже выставленные лимитные заявки ---
+TEST(OrderFlowTest, CancelsTargetEarlierLimits) {
+    OrderFlowConfig config;
+    config.cancelWindow = 128;
+    std::unordered_set<uint64_t> limits;
+    uint64_t expectedSequence = 0;
+    for (const auto& record : generate(config, 50000)) {
+        EXPECT_EQ(record.sequence, ++expectedSequence);
+        if (record.kind == JournalKind::Cancel)
+            EXPECT_TRUE(limits.count(record.targetId)) << record.targetId;
+        else if (static_cast<OrderType>(record.type) == OrderType::Limit)
+            limits.insert(record.id);
+    }
+}
+
+// --- 5. Файл читается через OrderFile и прогоняется через движок ---
+TEST(OrderFlowTest, FileReplaysThroughEngine) {
+    auto path = (std::filesystem::temp_directory_path() / "orderbook_flow.bin").string();
+    OrderFlowConfig config;
+    config.seed = 3;
+    OrderFlowGenerator generator(config);
+    writeOrderFlow(generator, 30000, path);
+
+    OrderFile file(path);
+    auto records = file.records();
+    ASSERT_EQ(records.size(), 30000u);
+    EXPECT_TRUE(sameRecords(std::vector<JournalRecord>(records.begin(), records.end()), generate(config, 30000)));
+
+    MatchingEngine engine(LogMode::Off, OrderBookConfig{ .orderCapacity = 1 << 15 }, 0);
+    for (const auto& record : records)
+        engine.apply(record);
+    EXPECT_EQ(engine.inputSequence(), 30000u);
+    EXPECT_GT(engine.getOrderBook().getTrades().nextSequence(), 0u);
+    std::filesystem::remove(path);
+}
+
+// --- 6. Несогласованная конфигурация отклоняется ---
+TEST(OrderFlowTest, RejectsInvalidConfig) {
+    OrderFlowConfig config;
+    config.cancelPercent = 50; // сумма 120%
+    EXPECT_THROW(OrderFlowGenerator{ config }, std::invalid_argument);
+
+    config = {};
+    config.tickSize = 0.0;
+    EXPECT_THROW(OrderFlowGenerator{ config }, std::invalid_argument);
+
+    config = {};
+    config.minPrice = 200.0;
+    config.maxPrice = 100.0;
+    EXPECT_THROW(OrderFlowGenerator{ config }, std::invalid_argument);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "../include/order_book.hpp"
+#include <array>
+#include <filesystem>
+#include <limits>
 
 // --- 1. Простая сделка (один покупатель и продавец) ---
 TEST(OrderBookTest, SimpleMatch) {
@@ -85,3 +88,555 @@ TEST(OrderBookTest, AddRemainingAfterPartial) {
     // После сделки покупатель должен добавить остаток в bids
     ob.printBook();
 }
+
+// --- 8. Market sweep через далёкие друг от друга уровни ---
+TEST(OrderBookTest, MarketSweepAcrossSparseLevels) {
+    OrderBook ob;
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 99.0, 5});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 5000.0, 5});
+    ob.processOrder({3, Side::Sell, OrderType::Limit, 9999.0, 5});
+    ob.processOrder({4, Side::Buy, OrderType::Market, 0.0, 12});
+    auto trades = ob.getTrades();
+
+    ASSERT_EQ(trades.size(), 3);
+    EXPECT_EQ(trades[0].price, 99.0);
+    EXPECT_EQ(trades[1].price, 5000.0);
+    EXPECT_EQ(trades[2].price, 9999.0);
+    EXPECT_EQ(trades[2].quantity, 2);
+
+    // Лучший bid должен пересчитываться после опустошения уровня
+    ob.processOrder({5, Side::Buy, OrderType::Limit, 10.0, 5});
+    ob.processOrder({6, Side::Buy, OrderType::Limit, 20.0, 5});
+    ob.processOrder({7, Side::Sell, OrderType::Market, 0.0, 7});
+    trades = ob.getTrades();
+    ASSERT_EQ(trades.size(), 5);
+    EXPECT_EQ(trades[3].price, 20.0);
+    EXPECT_EQ(trades[4].price, 10.0);
+}
+
+// --- 9. Иерархический bitmap: поиск следующего/предыдущего уровня ---
+TEST(PriceBitmapTest, FindNextAndPrev) {
+    PriceBitmap bits(1'000'001);
+    EXPECT_EQ(bits.findFirst(), PriceBitmap::npos);
+    EXPECT_EQ(bits.findLast(), PriceBitmap::npos);
+
+    bits.set(3);
+    bits.set(4096);
+    bits.set(1'000'000);
+    EXPECT_EQ(bits.findFirst(), 3);
+    EXPECT_EQ(bits.findLast(), 1'000'000);
+    EXPECT_EQ(bits.findNext(4), 4096);
+    EXPECT_EQ(bits.findNext(4097), 1'000'000);
+    EXPECT_EQ(bits.findPrev(999'999), 4096);
+    EXPECT_EQ(bits.findPrev(4095), 3);
+    EXPECT_EQ(bits.findPrev(2), PriceBitmap::npos);
+
+    bits.clear(4096);
+    EXPECT_EQ(bits.findNext(4), 1'000'000);
+    EXPECT_EQ(bits.findPrev(999'999), 3);
+    bits.clear(3);
+    bits.clear(1'000'000);
+    EXPECT_TRUE(bits.empty());
+}
+
+// --- 10. Отмена ордера из середины уровня ---
+TEST(OrderBookTest, CancelKeepsFIFOOfRemainingOrders) {
+    OrderBook ob;
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 5});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 100.0, 6});
+    ob.processOrder({3, Side::Sell, OrderType::Limit, 100.0, 7});
+
+    EXPECT_TRUE(ob.cancelOrder(2));
+    EXPECT_FALSE(ob.cancelOrder(2));
+    EXPECT_EQ(ob.findOrder(2), nullptr);
+
+    ob.processOrder({4, Side::Buy, OrderType::Market, 0.0, 12});
+    auto trades = ob.getTrades();
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].sell_id, 1);
+    EXPECT_EQ(trades[1].sell_id, 3);
+    EXPECT_EQ(trades[1].quantity, 7);
+}
+
+// --- 11. Уменьшение объёма сохраняет приоритет, отмена последнего ордера очищает уровень ---
+TEST(OrderBookTest, ReduceAndCancelLastOrder) {
+    OrderBook ob;
+    ob.processOrder({1, Side::Buy, OrderType::Limit, 100.0, 10});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 10});
+    ob.processOrder({3, Side::Buy, OrderType::Limit, 99.0, 10});
+
+    EXPECT_FALSE(ob.reduceOrder(1, 15)); // увеличение не допускается
+    EXPECT_TRUE(ob.reduceOrder(1, 4));
+    ASSERT_NE(ob.findOrder(1), nullptr);
+    EXPECT_EQ(ob.findOrder(1)->quantity, 4);
+
+    ob.processOrder({4, Side::Sell, OrderType::Market, 0.0, 4});
+    EXPECT_EQ(ob.getTrades().back().buy_id, 1);
+
+    // Лучший bid после отмены единственного ордера уровня — 99.0
+    EXPECT_TRUE(ob.cancelOrder(2));
+    ob.processOrder({5, Side::Sell, OrderType::Market, 0.0, 1});
+    EXPECT_EQ(ob.getTrades().back().price, 99.0);
+}
+
+// --- 12. Cancel/replace теряет приоритет и может исполниться ---
+TEST(OrderBookTest, ReplaceResubmitsOrder) {
+    OrderBook ob;
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 101.0, 10});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 99.0, 10});
+
+    EXPECT_FALSE(ob.replaceOrder(42, {42, Side::Buy, OrderType::Limit, 101.0, 10}));
+    EXPECT_TRUE(ob.replaceOrder(2, {2, Side::Buy, OrderType::Limit, 101.0, 10}));
+    ASSERT_EQ(ob.getTrades().size(), 1);
+    EXPECT_EQ(ob.getTrades().back().buy_id, 2);
+    EXPECT_EQ(ob.findOrder(1), nullptr);
+}
+
+// --- 13. Цены с фиксированной точкой: 0.1 + 0.2 == 0.3 ---
+TEST(OrderBookTest, FixedPointPricesMatchExactly) {
+    OrderBook ob(0.0, 1.0, 0.01);
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 0.1 + 0.2, 10});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 0.3, 10});
+    auto trades = ob.getTrades();
+
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades.back().price, Price{ 0.3 });
+    EXPECT_EQ(trades.back().price.raw(), 300'000);
+    EXPECT_DOUBLE_EQ(trades.back().price.toDouble(), 0.3);
+}
+
+// --- 14. Скользящее окно: далёкие уровни уходят в overflow, окно следует за рынком ---
+TEST(OrderBookTest, SlidingWindowFollowsMarket) {
+    OrderBook ob(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 10000.0, .tickSize = 0.01,
+                                  .orderCapacity = 1024, .windowLevels = 1024 });
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 100.00, 5});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 99.99, 5});
+    ob.processOrder({3, Side::Sell, OrderType::Limit, 9000.00, 10}); // далеко от окна
+    ob.processOrder({4, Side::Buy, OrderType::Limit, 1.00, 5});
+
+    EXPECT_EQ(ob.getAsks().windowSize(), 1024);
+    EXPECT_EQ(ob.getAsks().overflowLevels(), 1);
+    EXPECT_EQ(ob.getBids().overflowLevels(), 1);
+
+    // Рынок уходит вверх: лучший ask теперь 9000, окно перецентрируется на mid
+    ob.processOrder({5, Side::Buy, OrderType::Market, 0.0, 10});
+    auto trades = ob.getTrades();
+    ASSERT_EQ(trades.size(), 2);
+    EXPECT_EQ(trades[0].price, 100.0);
+    EXPECT_EQ(trades[1].price, 9000.0);
+    size_t mid{ (9'999 + 900'000) / 2 };
+    EXPECT_LE(ob.getAsks().base(), mid);
+    EXPECT_GT(ob.getAsks().base() + ob.getAsks().windowSize(), mid);
+    EXPECT_EQ(ob.getBids().base(), ob.getAsks().base());
+
+    // Оба лучших уровня теперь вне окна, но по-прежнему находятся за O(1)
+    ob.processOrder({6, Side::Sell, OrderType::Market, 0.0, 7});
+    trades = ob.getTrades();
+    ASSERT_EQ(trades.size(), 4);
+    EXPECT_EQ(trades[2].price, 99.99);
+    EXPECT_EQ(trades[3].price, 1.0);
+}
+
+// --- 15. Окно и плотная лестница дают одинаковые сделки ---
+TEST(OrderBookTest, WindowedLadderMatchesDense) {
+    OrderBook dense(0.0, 1000.0, 0.01);
+    OrderBook windowed(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 1000.0, .tickSize = 0.01,
+                                        .orderCapacity = 1024, .windowLevels = 256 });
+    uint64_t seed{ 12345 };
+    auto next = [&seed]() { seed = seed * 6364136223846793005ULL + 1442695040888963407ULL; return seed >> 33; };
+
+    int64_t mid{ 50'000 };
+    for (uint64_t id = 0; id < 20'000; ++id) {
+        mid += static_cast<int64_t>(next() % 21) - 10;
+        mid = std::clamp<int64_t>(mid, 1'000, 99'000);
+        Side side{ next() % 2 == 0 ? Side::Buy : Side::Sell };
+        OrderType type{ next() % 10 == 0 ? OrderType::Market : OrderType::Limit };
+        int64_t ticks{ mid + (side == Side::Buy ? -1 : 1) * static_cast<int64_t>(next() % 400) };
+        Order order{ id, side, type, Price::fromRaw(ticks * 10'000), 1 + next() % 20 };
+        dense.processOrder(order);
+        windowed.processOrder(order);
+        if (id % 7 == 0) {
+            dense.cancelOrder(id / 2);
+            windowed.cancelOrder(id / 2);
+        }
+    }
+
+    const auto& a = dense.getTrades();
+    const auto& b = windowed.getTrades();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].buy_id, b[i].buy_id);
+        ASSERT_EQ(a[i].sell_id, b[i].sell_id);
+        ASSERT_EQ(a[i].price, b[i].price);
+        ASSERT_EQ(a[i].quantity, b[i].quantity);
+    }
+}
+
+// --- 16. Ограниченный поток сделок: хранятся только последние, номера растут ---
+TEST(OrderBookTest, TradeStreamKeepsRecentTrades) {
+    OrderBook ob(OrderBookConfig{ .minPrice = 0.0, .maxPrice = 1000.0, .tickSize = 0.01,
+                                  .orderCapacity = 64, .tradeRetention = 4 });
+    for (uint64_t i = 0; i < 10; ++i) {
+        ob.processOrder({2 * i, Side::Sell, OrderType::Limit, 100.0, 1});
+        ob.processOrder({2 * i + 1, Side::Buy, OrderType::Limit, 100.0, 1});
+    }
+
+    const auto& trades = ob.getTrades();
+    EXPECT_EQ(trades.nextSequence(), 10);
+    EXPECT_EQ(trades.firstSequence(), 6);
+    ASSERT_EQ(trades.size(), 4);
+    EXPECT_EQ(trades.front().buy_id, 13);
+    EXPECT_EQ(trades.back().buy_id, 19);
+
+    // Курсор отстал: выпавшие из окна сделки пропускаются, пробел виден по номерам
+    uint64_t cursor = 2;
+    std::vector<uint64_t> seen;
+    EXPECT_EQ(trades.poll(cursor, [&](uint64_t seq, const Trade&) { seen.push_back(seq); }), 4);
+    EXPECT_EQ(seen, (std::vector<uint64_t>{ 6, 7, 8, 9 }));
+    EXPECT_EQ(cursor, 10);
+    EXPECT_EQ(trades.poll(cursor, [](uint64_t, const Trade&) {}), 0);
+
+    OrderBook silent(OrderBookConfig{ .orderCapacity = 64, .tradeRetention = 0 });
+    silent.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 1});
+    silent.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 1});
+    EXPECT_TRUE(silent.getTrades().empty());
+    EXPECT_EQ(silent.getTrades().nextSequence(), 1);
+#ifndef NDEBUG
+    // Доступ вне окна — ошибка вызывающего: assert вместо фиктивной сделки
+    EXPECT_DEATH(silent.getTrades().back(), "empty window");
+    EXPECT_DEATH(silent.getTrades()[0], "outside the retained window");
+    EXPECT_DEATH(trades[4], "outside the retained window"); // в окне 4 сделки
+#endif
+}
+
+// Приёмник без std::function: считает сделки и изменения уровней
+struct CountingSink
+{
+    uint64_t trades = 0;
+    uint64_t volume = 0;
+    uint64_t levelUpdates = 0;
+    void onTrade(const Trade& trade) { ++trades; volume += trade.quantity; }
+    static constexpr bool wantsLevelUpdates() { return true; }
+    void onLevelUpdate(Side, Price, uint64_t) { ++levelUpdates; }
+};
+
+// --- 17. Стакан на политиках времени компиляции матчит так же, как OrderBook ---
+TEST(OrderBookTest, PolicyBookMatchesDefault) {
+    OrderBookConfig config{ .minPrice = 0.0, .maxPrice = 1000.0, .tickSize = 0.01, .orderCapacity = 1024 };
+    OrderBook classic(config);
+    BasicOrderBook<CountingSink, FixedTick<10'000>> inlined(config);
+    uint64_t callbackTrades = 0, callbackUpdates = 0;
+    classic.setOnTradeCallback([&](const Trade&) { ++callbackTrades; });
+    classic.setOnLevelUpdateCallback([&](Side, Price, uint64_t) { ++callbackUpdates; });
+
+    uint64_t seed{ 777 };
+    auto next = [&seed]() { seed = seed * 6364136223846793005ULL + 1442695040888963407ULL; return seed >> 33; };
+    for (uint64_t id = 0; id < 20'000; ++id) {
+        Side side{ next() % 2 == 0 ? Side::Buy : Side::Sell };
+        OrderType type{ next() % 10 == 0 ? OrderType::Market : OrderType::Limit };
+        int64_t ticks{ 50'000 + (side == Side::Buy ? -1 : 1) * (static_cast<int64_t>(next() % 60) - 10) };
+        Order order{ id, side, type, Price::fromRaw(ticks * 10'000), 1 + next() % 20 };
+        classic.processOrder(order);
+        inlined.processOrder(order);
+        if (id % 5 == 0) {
+            classic.cancelOrder(id / 2);
+            inlined.cancelOrder(id / 2);
+        }
+    }
+
+    const auto& a = classic.getTrades();
+    const auto& b = inlined.getTrades();
+    ASSERT_GT(a.size(), 1000u);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].buy_id, b[i].buy_id);
+        ASSERT_EQ(a[i].sell_id, b[i].sell_id);
+        ASSERT_EQ(a[i].price, b[i].price);
+        ASSERT_EQ(a[i].quantity, b[i].quantity);
+    }
+    EXPECT_EQ(inlined.tradeSink().trades, callbackTrades);
+    EXPECT_EQ(inlined.tradeSink().levelUpdates, callbackUpdates);
+
+    // Шаг времени компиляции должен совпадать с конфигурацией
+    EXPECT_THROW((BasicOrderBook<NullSink, FixedTick<10'000>>(OrderBookConfig{ .tickSize = 0.05 })), std::invalid_argument);
+}
+
+// --- 18. Аукцион: заявки копятся без сделок, uncross по цене максимального объёма ---
+TEST(OrderBookTest, AuctionUncrossesAtMaxVolume) {
+    OrderBook ob(90.0, 110.0, 0.01);
+    ob.startAuction();
+    ob.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 10});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 20});
+    ob.processOrder({3, Side::Buy, OrderType::Limit, 99.0, 5});
+    ob.processOrder({4, Side::Sell, OrderType::Limit, 98.0, 15});
+    ob.processOrder({5, Side::Sell, OrderType::Limit, 100.0, 10});
+    ob.processOrder({6, Side::Sell, OrderType::Limit, 102.0, 10});
+    ob.processOrder({7, Side::Buy, OrderType::Market, 0.0, 50}); // в аукционе отбрасывается
+    EXPECT_TRUE(ob.getTrades().empty());
+    EXPECT_EQ(ob.phase(), TradingPhase::Auction);
+
+    // Объём по уровням 98/99/100/101: 15, 15, 25, 10
+    AuctionResult indicative = ob.indicativeUncross();
+    EXPECT_EQ(indicative.price, Price{ 100.0 });
+    EXPECT_EQ(indicative.volume, 25);
+    EXPECT_EQ(indicative.imbalance, 5);
+    EXPECT_TRUE(ob.getTrades().empty());
+
+    AuctionResult result = ob.uncross();
+    EXPECT_EQ(result.volume, 25);
+    EXPECT_EQ(ob.phase(), TradingPhase::Continuous);
+    const auto& trades = ob.getTrades();
+    ASSERT_EQ(trades.size(), 3);
+    // Приоритет цена-время, все сделки по одной цене
+    EXPECT_EQ(std::make_tuple(trades[0].buy_id, trades[0].sell_id, trades[0].quantity), std::make_tuple(1u, 4u, 10u));
+    EXPECT_EQ(std::make_tuple(trades[1].buy_id, trades[1].sell_id, trades[1].quantity), std::make_tuple(2u, 4u, 5u));
+    EXPECT_EQ(std::make_tuple(trades[2].buy_id, trades[2].sell_id, trades[2].quantity), std::make_tuple(2u, 5u, 10u));
+    for (size_t i = 0; i < trades.size(); ++i)
+        EXPECT_EQ(trades[i].price, Price{ 100.0 });
+
+    ASSERT_NE(ob.findOrder(2), nullptr);
+    EXPECT_EQ(ob.findOrder(2)->quantity, 5);
+    EXPECT_EQ(ob.findOrder(4), nullptr);
+    EXPECT_EQ(ob.indicativeUncross().volume, 0); // стакан больше не пересечён
+}
+
+// --- 19. Равный объём: минимальный дисбаланс, затем давление стороны или середина ---
+TEST(OrderBookTest, AuctionTieBreaks) {
+    // 99: объём 10, дисбаланс 4; 100 и 101: объём 10, дисбаланс 0 -> середина, 100
+    OrderBook balanced(90.0, 110.0, 1.0);
+    balanced.startAuction();
+    balanced.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 10});
+    balanced.processOrder({2, Side::Buy, OrderType::Limit, 99.0, 4});
+    balanced.processOrder({3, Side::Sell, OrderType::Limit, 99.0, 10});
+    AuctionResult result = balanced.indicativeUncross();
+    EXPECT_EQ(result.price, Price{ 100.0 });
+    EXPECT_EQ(result.volume, 10);
+    EXPECT_EQ(result.imbalance, 0);
+
+    // Везде перевес покупателя на 2 -> самая высокая цена
+    OrderBook buyers(90.0, 110.0, 1.0);
+    buyers.startAuction();
+    buyers.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 12});
+    buyers.processOrder({2, Side::Sell, OrderType::Limit, 99.0, 10});
+    EXPECT_EQ(buyers.indicativeUncross().price, Price{ 101.0 });
+    EXPECT_EQ(buyers.indicativeUncross().imbalance, 2);
+
+    OrderBook sellers(90.0, 110.0, 1.0);
+    sellers.startAuction();
+    sellers.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 10});
+    sellers.processOrder({2, Side::Sell, OrderType::Limit, 99.0, 12});
+    EXPECT_EQ(sellers.indicativeUncross().price, Price{ 99.0 });
+    EXPECT_EQ(sellers.indicativeUncross().imbalance, -2);
+}
+
+// --- 20. Аукцион без пересечения: сделок нет, торги продолжаются ---
+TEST(OrderBookTest, AuctionWithoutCross) {
+    OrderBook ob(90.0, 110.0, 0.01);
+    ob.startAuction();
+    ob.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 101.0, 10});
+    AuctionResult result = ob.uncross();
+    EXPECT_EQ(result.volume, 0);
+    EXPECT_TRUE(ob.getTrades().empty());
+    EXPECT_EQ(ob.phase(), TradingPhase::Continuous);
+
+    ob.processOrder({3, Side::Buy, OrderType::Market, 0.0, 4});
+    ASSERT_EQ(ob.getTrades().size(), 1);
+    EXPECT_EQ(ob.getTrades()[0].sell_id, 2);
+}
+
+// --- 21. Запросы глубины: top-N, накопленная глубина, VWAP, FOK/IOC ---
+TEST(OrderBookTest, DepthQueries) {
+    OrderBook ob(90.0, 110.0, 0.01);
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 4});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 100.0, 6});
+    ob.processOrder({3, Side::Sell, OrderType::Limit, 101.0, 5});
+    ob.processOrder({4, Side::Sell, OrderType::Limit, 103.0, 20});
+    ob.processOrder({5, Side::Buy, OrderType::Limit, 99.0, 7});
+    ob.processOrder({6, Side::Buy, OrderType::Limit, 98.0, 1});
+    ob.processOrder({7, Side::Buy, OrderType::Limit, 98.0, 2});
+
+    std::array<DepthLevel, 2> top{};
+    ASSERT_EQ(ob.depth(Side::Sell, top), 2);
+    EXPECT_EQ(top[0].price, Price{ 100.0 });
+    EXPECT_EQ(top[0].quantity, 10);
+    EXPECT_EQ(top[0].orders, 2);
+    EXPECT_EQ(top[1].price, Price{ 101.0 });
+    std::array<DepthLevel, 8> bids{};
+    ASSERT_EQ(ob.depth(Side::Buy, bids), 2);
+    EXPECT_EQ(bids[1].quantity, 3);
+    EXPECT_EQ(bids[1].orders, 2);
+
+    EXPECT_EQ(ob.cumulativeDepth(Side::Sell, 101.0), 15);
+    EXPECT_EQ(ob.cumulativeDepth(Side::Sell, 99.0), 0);
+    EXPECT_EQ(ob.cumulativeDepth(Side::Buy, 98.0), 10);
+    EXPECT_EQ(ob.cumulativeDepth(Side::Buy, 90.0), 10);
+
+    // Покупка 12: 10 по 100 и 2 по 101
+    FillEstimate buy = ob.estimateFill(Side::Buy, 12);
+    EXPECT_EQ(buy.quantity, 12);
+    EXPECT_EQ(buy.levels, 2);
+    EXPECT_EQ(buy.notional, Price{ 100.0 }.raw() * 10 + Price{ 101.0 }.raw() * 2);
+    EXPECT_EQ(buy.vwap(), Price::fromRaw((Price{ 100.0 }.raw() * 10 + Price{ 101.0 }.raw() * 2 + 6) / 12));
+
+    EXPECT_TRUE(ob.canFillAll(Side::Buy, 15, Price{ 101.0 }));
+    EXPECT_FALSE(ob.canFillAll(Side::Buy, 16, Price{ 101.0 }));
+    EXPECT_TRUE(ob.canFillAll(Side::Buy, 35));
+    EXPECT_FALSE(ob.canFillAll(Side::Buy, 36));
+    EXPECT_EQ(ob.fillableQuantity(Side::Sell, 100, Price{ 98.5 }), 7);
+    EXPECT_EQ(ob.fillableQuantity(Side::Sell, 5, Price{ 98.0 }), 5);
+    EXPECT_EQ(ob.estimateFill(Side::Sell, 0).vwap(), Price{ 0.0 });
+    EXPECT_FALSE(buy.saturated);
+
+    // Оборот сверх int64 насыщается и помечается, а не заворачивается через знак
+    ob.processOrder({20, Side::Sell, OrderType::Limit, 9000.0, 1'000'000'000});
+    ob.processOrder({21, Side::Sell, OrderType::Limit, 10000.0, 1'000'000'000});
+    FillEstimate huge = ob.estimateFill(Side::Buy, 2'000'000'000);
+    EXPECT_EQ(huge.quantity, 2'000'000'000u);
+    EXPECT_TRUE(huge.saturated);
+    EXPECT_EQ(huge.notional, std::numeric_limits<int64_t>::max());
+    EXPECT_GT(huge.vwap(), Price{ 0.0 });
+    ob.cancelOrder(20);
+    ob.cancelOrder(21);
+
+    // Запросы не меняют стакан
+    EXPECT_TRUE(ob.getTrades().empty());
+    EXPECT_EQ(ob.findOrder(1)->quantity, 4);
+}
+
+// Стоп-заявка с заданной ценой срабатывания
+static Order stopOrder(uint64_t id, Side side, OrderType type, double price, double stop, uint64_t qty) {
+    Order order{ id, side, type, price, qty };
+    order.stopPrice = stop;
+    return order;
+}
+
+// --- 22. Stop и StopLimit: срабатывание по цене последней сделки, отмена ---
+TEST(OrderBookTest, StopOrdersTriggerOnLastTrade) {
+    OrderBook ob;
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 5});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 101.0, 5});
+    ob.processOrder(stopOrder(10, Side::Buy, OrderType::Stop, 0.0, 101.0, 3));
+    ASSERT_NE(ob.findOrder(10), nullptr);
+    EXPECT_FALSE(ob.lastTradePrice().has_value());
+
+    // Сделка по 100 ниже цены срабатывания
+    ob.processOrder({3, Side::Buy, OrderType::Limit, 101.0, 5});
+    EXPECT_EQ(ob.lastTradePrice(), Price{ 100.0 });
+    EXPECT_TRUE(ob.lastActivations().empty());
+    EXPECT_NE(ob.findOrder(10), nullptr);
+
+    // Сделка по 101 запускает стоп: рыночная покупка 3
+    ob.processOrder({4, Side::Buy, OrderType::Limit, 101.0, 2});
+    EXPECT_EQ(ob.lastFillQty(), 2);
+    ASSERT_EQ(ob.lastActivations().size(), 1);
+    const StopActivation& fired = ob.lastActivations()[0];
+    EXPECT_EQ(fired.id, 10);
+    EXPECT_EQ(fired.type, OrderType::Market);
+    EXPECT_EQ(fired.filledQty, 3);
+    EXPECT_EQ(fired.leavesQty, 0);
+    EXPECT_EQ(ob.findOrder(10), nullptr);
+    EXPECT_EQ(ob.getTrades().back().buy_id, 10);
+    EXPECT_EQ(ob.getAsks().best(), PriceLadder::npos);
+
+    // StopLimit на продажу встаёт лимитной заявкой после срабатывания
+    ob.processOrder({5, Side::Buy, OrderType::Limit, 99.0, 2});
+    ob.processOrder({6, Side::Buy, OrderType::Limit, 98.0, 10});
+    ob.processOrder(stopOrder(20, Side::Sell, OrderType::StopLimit, 98.5, 99.0, 4));
+    ob.processOrder({7, Side::Sell, OrderType::Limit, 99.0, 2});
+    ASSERT_EQ(ob.lastActivations().size(), 1);
+    EXPECT_EQ(ob.lastActivations()[0].type, OrderType::Limit);
+    EXPECT_EQ(ob.lastActivations()[0].leavesQty, 4);
+    ASSERT_NE(ob.findOrder(20), nullptr);
+    EXPECT_EQ(ob.findOrder(20)->type, OrderType::Limit);
+    EXPECT_EQ(ob.findOrder(20)->price, Price{ 98.5 });
+
+    // Взведённые стопы отменяются и уменьшаются как обычные заявки
+    ob.processOrder(stopOrder(30, Side::Sell, OrderType::Stop, 0.0, 90.0, 1));
+    ob.processOrder(stopOrder(31, Side::Sell, OrderType::Stop, 0.0, 90.0, 5));
+    EXPECT_TRUE(ob.cancelOrder(30));
+    EXPECT_EQ(ob.findOrder(30), nullptr);
+    EXPECT_TRUE(ob.reduceOrder(31, 2));
+    EXPECT_EQ(ob.findOrder(31)->quantity, 2);
+}
+
+// --- 23. Каскад стопов ограничен и детерминирован ---
+TEST(OrderBookTest, StopCascadeIsBounded) {
+    OrderBook ob(OrderBookConfig{ .maxStopCascade = 2 });
+    for (uint64_t i = 0; i < 4; ++i)
+        ob.processOrder({i + 1, Side::Sell, OrderType::Limit, 100.0 + static_cast<double>(i), 1});
+    // Две заявки в одной корзине срабатывают в порядке поступления
+    ob.processOrder(stopOrder(10, Side::Buy, OrderType::Stop, 0.0, 100.0, 1));
+    ob.processOrder(stopOrder(11, Side::Buy, OrderType::Stop, 0.0, 100.0, 1));
+    ob.processOrder(stopOrder(12, Side::Buy, OrderType::Stop, 0.0, 102.0, 1));
+
+    // 100 -> стоп 10 берёт 101 -> стоп 11 берёт 102; лимит каскада исчерпан
+    ob.processOrder({5, Side::Buy, OrderType::Limit, 100.0, 1});
+    ASSERT_EQ(ob.lastActivations().size(), 2);
+    EXPECT_EQ(ob.lastActivations()[0].id, 10);
+    EXPECT_EQ(ob.lastActivations()[1].id, 11);
+    EXPECT_EQ(ob.lastTradePrice(), Price{ 102.0 });
+    EXPECT_NE(ob.findOrder(12), nullptr);
+
+    // Оставшийся стоп срабатывает после следующей заявки
+    ob.processOrder({6, Side::Buy, OrderType::Limit, 90.0, 1});
+    ASSERT_EQ(ob.lastActivations().size(), 1);
+    EXPECT_EQ(ob.lastActivations()[0].id, 12);
+    EXPECT_EQ(ob.lastTradePrice(), Price{ 103.0 });
+    EXPECT_EQ(ob.getTrades().size(), 4);
+}
+
+// --- 24. Отложенный стоп срабатывает по достигнутой цене, даже если цена вернулась ---
+TEST(OrderBookTest, DeferredStopFiresAfterPriceReturns) {
+    OrderBook ob(OrderBookConfig{ .maxStopCascade = 1 });
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 101.0, 1});
+    ob.processOrder({2, Side::Sell, OrderType::Limit, 102.0, 1});
+    ob.processOrder({3, Side::Sell, OrderType::Limit, 103.0, 1});
+    ob.processOrder({4, Side::Buy, OrderType::Limit, 95.0, 1});
+    ob.processOrder(stopOrder(10, Side::Buy, OrderType::Stop, 0.0, 101.0, 1));
+    ob.processOrder(stopOrder(11, Side::Buy, OrderType::Stop, 0.0, 101.0, 1));
+
+    // 101 запускает стоп 10 (сделка по 102), стоп 11 откладывается лимитом каскада
+    ob.processOrder({5, Side::Buy, OrderType::Limit, 101.0, 1});
+    ASSERT_EQ(ob.lastActivations().size(), 1);
+    EXPECT_EQ(ob.lastActivations()[0].id, 10);
+    ASSERT_NE(ob.findOrder(11), nullptr);
+
+    // Отложенное состояние переживает снимок
+    auto path = (std::filesystem::temp_directory_path() / "orderbook_deferred_stop.bin").string();
+    ob.saveSnapshot(path, 0);
+    OrderBook restored(OrderBookConfig{ .maxStopCascade = 1 });
+    restored.loadSnapshot(path);
+    std::filesystem::remove(path);
+
+    // Цена уходит обратно ниже 101 до следующей заявки: стоп 11 всё равно срабатывает
+    for (OrderBook* book : { &ob, &restored }) {
+        book->processOrder({6, Side::Sell, OrderType::Limit, 95.0, 1});
+        ASSERT_EQ(book->lastActivations().size(), 1);
+        EXPECT_EQ(book->lastActivations()[0].id, 11);
+        EXPECT_EQ(book->lastActivations()[0].filledQty, 1);
+        EXPECT_EQ(book->findOrder(11), nullptr);
+        EXPECT_EQ(book->lastTradePrice(), Price{ 103.0 });
+    }
+
+    // Полный проход сбрасывает диапазон: стоп на продажу по 96 ждёт новой сделки ниже
+    ob.processOrder(stopOrder(12, Side::Sell, OrderType::Stop, 0.0, 96.0, 1));
+    EXPECT_TRUE(ob.lastActivations().empty());
+    EXPECT_NE(ob.findOrder(12), nullptr);
+}
+
+// --- 25. Оборот исполнений насыщается вместо переполнения int64 ---
+TEST(OrderBookTest, FillNotionalSaturates) {
+    // Книга сама объём не ограничивает (это делает acceptsOrder на входе в движок)
+    OrderBook ob;
+    ob.processOrder({1, Side::Sell, OrderType::Limit, 10000.0, 1'000'000'000});
+    ob.processOrder({2, Side::Buy, OrderType::Limit, 10000.0, 500'000'000});
+    EXPECT_EQ(ob.lastFillNotional(), Price{ 10000.0 }.raw() * 500'000'000);
+    ob.processOrder({3, Side::Buy, OrderType::Market, 0.0, 500'000'000});
+    EXPECT_EQ(ob.lastFillNotional(), Price{ 10000.0 }.raw() * 500'000'000);
+
+    ob.processOrder({4, Side::Sell, OrderType::Limit, 10000.0, 1'000'000'000});
+    ob.processOrder({5, Side::Buy, OrderType::Market, 0.0, 1'000'000'000});
+    EXPECT_EQ(ob.lastFillQty(), 1'000'000'000u);
+    EXPECT_EQ(ob.lastFillNotional(), std::numeric_limits<int64_t>::max());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../include/pipeline.hpp"
+#include "../include/order_flow.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+
+static std::vector<JournalRecord> makeFlow(std::size_t count) {
+    OrderFlowConfig config;
+    config.seed = 23;
+    OrderFlowGenerator generator(config);
+    std::vector<JournalRecord> records(count);
+    generator.generate(records.data(), records.size());
+    return records;
+}
+
+// --- 1. Каждая стратегия ожидания даёт тот же результат, что и движок напрямую ---
+TEST(PipelineTest, MatchesDirectEngineForEveryWaitStrategy) {
+    auto records = makeFlow(5000);
+    MatchingEngine direct(LogMode::Off);
+    for (const auto& record : records)
+        direct.apply(record);
+
+    for (WaitStrategy strategy : { WaitStrategy::BusySpin, WaitStrategy::SpinYield, WaitStrategy::Futex }) {
+        PipelineConfig config;
+        config.wait = { strategy, strategy, strategy };
+        config.spinLimit = 64;
+        auto pipeline = std::make_unique<Pipeline>(config);
+
+        uint64_t reports = 0;
+        pipeline->setOnReport([&reports](const ExecutionReport&) { ++reports; });
+        pipeline->start();
+        for (const auto& record : records)
+            while (!pipeline->push(record))
+                std::this_thread::yield();
+        pipeline->stop();
+
+        const auto& engine = pipeline->engine();
+        SCOPED_TRACE(toString(strategy));
+        EXPECT_EQ(pipeline->report().inputs, records.size());
+        EXPECT_EQ(pipeline->report().reports, reports);
+        EXPECT_EQ(pipeline->report().latency.count, reports);
+        EXPECT_EQ(engine.getOrderBook().getTrades().nextSequence(), direct.getOrderBook().getTrades().nextSequence());
+        EXPECT_EQ(engine.getOrderBook().bestBid(), direct.getOrderBook().bestBid());
+        EXPECT_EQ(engine.getOrderBook().bestAsk(), direct.getOrderBook().bestAsk());
+        EXPECT_EQ(engine.inputSequence(), direct.inputSequence());
+    }
+}
+
+// --- 2. Несколько гейтвеев: все сообщения пронумерованы и обработаны ---
+TEST(PipelineTest, MultipleIngestThreads) {
+    PipelineConfig config;
+    config.wait = { WaitStrategy::Futex, WaitStrategy::SpinYield, WaitStrategy::Futex };
+    auto pipeline = std::make_unique<Pipeline>(config);
+    pipeline->start();
+
+    constexpr uint64_t kPerGateway = 2000;
+    std::vector<std::thread> gateways;
+    for (uint64_t g = 0; g < 3; ++g) {
+        gateways.emplace_back([&, g]() {
+            for (uint64_t i = 0; i < kPerGateway; ++i) {
+                uint64_t id = g * kPerGateway + i + 1;
+                pipeline->submit({ id, id % 2 ? Side::Buy : Side::Sell, OrderType::Limit, id % 2 ? 99.0 : 101.0, 1 });
+            }
+        });
+    }
+    for (auto& gateway : gateways)
+        gateway.join();
+    pipeline->stop();
+
+    EXPECT_EQ(pipeline->report().inputs, 3 * kPerGateway);
+    EXPECT_EQ(pipeline->report().reports, 3 * kPerGateway);
+    EXPECT_EQ(pipeline->engine().getMetrics().processed_orders.load(), 3 * kPerGateway);
+}
+
+// --- 3. Риск на потоке матчинга: отказ доходит до publish как Rejected ---
+TEST(PipelineTest, RiskRejectsReachPublisher) {
+    auto pipeline = std::make_unique<Pipeline>();
+    pipeline->enableRisk(2).setLimits(1, { .maxOrderQty = 10 });
+
+    std::vector<ExecutionReport> reports;
+    pipeline->setOnReport([&reports](const ExecutionReport& report) { reports.push_back(report); });
+    pipeline->start();
+    pipeline->submit({ 1, Side::Sell, OrderType::Limit, 100.0, 50, 0, 0 });
+    pipeline->submit({ 2, Side::Buy, OrderType::Limit, 100.0, 20, 0, 1 });
+    pipeline->submit({ 3, Side::Buy, OrderType::Limit, 100.0, 10, 0, 1 });
+    pipeline->cancel(1);
+    pipeline->stop();
+
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_EQ(reports[1].status, ExecStatus::Rejected);
+    EXPECT_EQ(reports[2].status, ExecStatus::Filled);
+    EXPECT_EQ(reports[3].status, ExecStatus::Canceled);
+    EXPECT_EQ(pipeline->risk()->exposure(1).position, 10);
+    EXPECT_EQ(pipeline->risk()->exposure(0).openSell, 0u);
+}
@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include "../include/matching_engine.hpp"
+#include "../include/order_file.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+// Путь во временном каталоге, файл удаляется перед тестом
+static std::string tempPath(const std::string& name) {
+    auto path = std::filesystem::temp_directory_path() / ("orderbook_" + name);
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+// Все заявки стакана в порядке приоритета: (id, цена, объём)
+static std::vector<std::tuple<uint64_t, int64_t, uint64_t>> restingOrders(const OrderBook& book, Side side) {
+    std::vector<std::tuple<uint64_t, int64_t, uint64_t>> orders;
+    book.forEachOrder(side, [&](const Order& order) {
+        orders.emplace_back(order.id, order.price.raw(), order.quantity);
+    });
+    return orders;
+}
+
+// --- 1. Снимок сохраняет заявки и приоритет внутри уровня ---
+TEST(RecoveryTest, SnapshotRestoresPriority) {
+    std::string path = tempPath("snapshot_priority.bin");
+    OrderBook book;
+    book.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+    book.processOrder({2, Side::Buy, OrderType::Limit, 99.0, 5});
+    book.processOrder({3, Side::Buy, OrderType::Limit, 98.5, 7});
+    book.processOrder({4, Side::Sell, OrderType::Limit, 101.0, 3});
+    book.processOrder({5, Side::Sell, OrderType::Limit, 100.0, 8});
+    book.processOrder({6, Side::Sell, OrderType::Limit, 98.0, 4}); // сделка с #1
+    book.saveSnapshot(path, 42);
+
+    OrderBook restored;
+    EXPECT_EQ(restored.loadSnapshot(path), 42);
+    EXPECT_EQ(restingOrders(restored, Side::Buy), restingOrders(book, Side::Buy));
+    EXPECT_EQ(restingOrders(restored, Side::Sell), restingOrders(book, Side::Sell));
+    EXPECT_EQ(restored.getTrades().nextSequence(), book.getTrades().nextSequence());
+
+    // Первым исполняется всё ещё #1 (остаток 6), затем #2
+    restored.processOrder({7, Side::Sell, OrderType::Market, 0.0, 8});
+    EXPECT_EQ(restored.getTrades().nextSequence(), 3);
+    ASSERT_EQ(restored.getTrades().size(), 2);
+    EXPECT_EQ(restored.getTrades()[0].buy_id, 1);
+    EXPECT_EQ(restored.getTrades()[0].quantity, 6);
+    EXPECT_EQ(restored.getTrades()[1].buy_id, 2);
+}
+
+// --- 2. Снимок не загружается в стакан с другой сеткой цен ---
+TEST(RecoveryTest, SnapshotRejectsDifferentGrid) {
+    std::string path = tempPath("snapshot_grid.bin");
+    OrderBook book;
+    book.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+    book.saveSnapshot(path, 1);
+
+    OrderBook other(0.0, 1000.0, 0.05);
+    EXPECT_THROW(other.loadSnapshot(path), std::runtime_error);
+    EXPECT_THROW(other.loadSnapshot(tempPath("missing.bin")), std::runtime_error);
+}
+
+// --- 3. Рестарт: снимок + хвост журнала дают то же состояние ---
+TEST(RecoveryTest, EngineRecoversFromSnapshotAndJournalTail) {
+    std::string snapshot = tempPath("engine_snapshot.bin");
+    std::string journal = tempPath("engine_journal.bin");
+
+    MatchingEngine original(LogMode::Off);
+    original.openJournal(journal);
+    for (uint64_t id = 1; id <= 200; ++id)
+        original.processOrder({id, id % 2 ? Side::Buy : Side::Sell, OrderType::Limit,
+                               id % 2 ? 99.0 - (id % 7) * 0.5 : 100.0 + (id % 5) * 0.5, 1 + id % 9});
+    original.saveSnapshot(snapshot);
+
+    // Хвост после снимка: все виды входящих сообщений
+    original.cancelOrder(3);
+    original.reduceOrder(5, 1);
+    original.replaceOrder(8, {201, Side::Sell, OrderType::Limit, 99.5, 4});
+    original.processOrder({202, Side::Buy, OrderType::Market, 0.0, 20});
+    original.processOrder({203, Side::Buy, OrderType::Limit, 101.0, 6});
+    original.saveSnapshot(tempPath("unused.bin")); // сбрасывает журнал на диск
+
+    MatchingEngine restarted(LogMode::Off);
+    EXPECT_EQ(restarted.recover(snapshot, journal), original.inputSequence());
+    EXPECT_EQ(restarted.getReports().size(), 6); // только 5 сообщений хвоста, замена даёт два отчёта
+    EXPECT_EQ(restingOrders(restarted.getOrderBook(), Side::Buy), restingOrders(original.getOrderBook(), Side::Buy));
+    EXPECT_EQ(restingOrders(restarted.getOrderBook(), Side::Sell), restingOrders(original.getOrderBook(), Side::Sell));
+    EXPECT_EQ(restarted.getOrderBook().getTrades().nextSequence(), original.getOrderBook().getTrades().nextSequence());
+
+    // Без снимка весь журнал переигрывается с начала
+    MatchingEngine fromJournal(LogMode::Off);
+    EXPECT_EQ(fromJournal.recover(tempPath("no_snapshot.bin"), journal), original.inputSequence());
+    EXPECT_EQ(restingOrders(fromJournal.getOrderBook(), Side::Buy), restingOrders(original.getOrderBook(), Side::Buy));
+}
+
+// --- 4. Оборванная последняя запись журнала игнорируется ---
+TEST(RecoveryTest, TornJournalRecordIsIgnored) {
+    std::string journal = tempPath("torn_journal.bin");
+    {
+        MatchingEngine engine(LogMode::Off);
+        engine.openJournal(journal);
+        engine.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+        engine.processOrder({2, Side::Buy, OrderType::Limit, 98.0, 10});
+    }
+    std::filesystem::resize_file(journal, sizeof(JournalFileHeader) + sizeof(JournalRecord) + 20);
+
+    MatchingEngine engine(LogMode::Off);
+    EXPECT_EQ(engine.recover(tempPath("no_snapshot.bin"), journal), 1);
+    EXPECT_NE(engine.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(engine.getOrderBook().findOrder(2), nullptr);
+}
+
+// --- 5. Журнал читается через mmap как файл потока ордеров ---
+TEST(RecoveryTest, OrderFileMapsJournal) {
+    std::string journal = tempPath("order_file.bin");
+    {
+        MatchingEngine engine(LogMode::Off);
+        engine.openJournal(journal);
+        engine.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 10});
+        engine.reduceOrder(1, 4);
+        engine.processOrder({2, Side::Buy, OrderType::Market, 0.0, 3});
+    }
+
+    OrderFile file(journal);
+    auto records = file.records();
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].kind, JournalKind::New);
+    EXPECT_EQ(records[1].kind, JournalKind::Reduce);
+    EXPECT_EQ(records[1].targetId, 1);
+    EXPECT_EQ(records[2].sequence, 3);
+
+    MatchingEngine replayed(LogMode::Off);
+    for (const auto& record : records)
+        replayed.apply(record);
+    ASSERT_NE(replayed.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(replayed.getOrderBook().findOrder(1)->quantity, 1);
+
+    EXPECT_THROW(OrderFile(tempPath("missing_orders.bin")), std::runtime_error);
+}
+
+// --- 6. Аукцион: фаза сохраняется в снимке, открытие и uncross журналируются ---
+TEST(RecoveryTest, AuctionPhaseSurvivesRestart) {
+    std::string snapshot = tempPath("auction_snapshot.bin");
+    std::string journal = tempPath("auction_journal.bin");
+
+    MatchingEngine original(LogMode::Off);
+    original.openJournal(journal);
+    original.startAuction();
+    original.processOrder({1, Side::Buy, OrderType::Limit, 101.0, 10});
+    original.processOrder({2, Side::Sell, OrderType::Limit, 99.0, 6});
+    original.saveSnapshot(snapshot); // стакан пересечён, идёт аукцион
+    original.processOrder({3, Side::Sell, OrderType::Limit, 100.0, 6});
+    original.uncross();
+    original.processOrder({4, Side::Sell, OrderType::Limit, 101.0, 1});
+    original.saveSnapshot(tempPath("unused.bin"));
+
+    MatchingEngine restarted(LogMode::Off);
+    EXPECT_EQ(restarted.recover(snapshot, journal), original.inputSequence());
+    EXPECT_EQ(restarted.getOrderBook().phase(), TradingPhase::Continuous);
+    EXPECT_EQ(restingOrders(restarted.getOrderBook(), Side::Buy), restingOrders(original.getOrderBook(), Side::Buy));
+    EXPECT_EQ(restingOrders(restarted.getOrderBook(), Side::Sell), restingOrders(original.getOrderBook(), Side::Sell));
+    EXPECT_EQ(restarted.getOrderBook().getTrades().nextSequence(), original.getOrderBook().getTrades().nextSequence());
+
+    OrderBook book;
+    book.loadSnapshot(snapshot);
+    EXPECT_EQ(book.phase(), TradingPhase::Auction);
+    EXPECT_EQ(book.indicativeUncross().volume, 6);
+}
+
+// --- 7. Взведённые стопы и цена последней сделки переживают рестарт ---
+TEST(RecoveryTest, ArmedStopsSurviveRestart) {
+    std::string snapshot = tempPath("stops_snapshot.bin");
+    std::string journal = tempPath("stops_journal.bin");
+
+    Order buyStop{10, Side::Buy, OrderType::Stop, 0.0, 2};
+    buyStop.stopPrice = 101.0;
+    Order sellStop{11, Side::Sell, OrderType::StopLimit, 94.0, 1};
+    sellStop.stopPrice = 95.0;
+
+    MatchingEngine original(LogMode::Off);
+    original.openJournal(journal);
+    original.processOrder({1, Side::Sell, OrderType::Limit, 100.0, 5});
+    original.processOrder({2, Side::Buy, OrderType::Limit, 100.0, 1});
+    original.processOrder(buyStop);
+    original.saveSnapshot(snapshot);
+    original.processOrder(sellStop); // только в журнале
+    original.processOrder({3, Side::Sell, OrderType::Limit, 101.0, 5});
+    original.processOrder({4, Side::Buy, OrderType::Limit, 100.0, 4});
+    original.processOrder({5, Side::Buy, OrderType::Limit, 101.0, 1}); // сделка по 101 запускает стоп 10
+    original.saveSnapshot(tempPath("unused.bin"));
+    ASSERT_EQ(original.getOrderBook().findOrder(10), nullptr);
+
+    MatchingEngine restarted(LogMode::Off);
+    EXPECT_EQ(restarted.recover(snapshot, journal), original.inputSequence());
+    EXPECT_EQ(restarted.getOrderBook().getTrades().nextSequence(), original.getOrderBook().getTrades().nextSequence());
+    EXPECT_EQ(restingOrders(restarted.getOrderBook(), Side::Sell), restingOrders(original.getOrderBook(), Side::Sell));
+    EXPECT_EQ(restarted.getOrderBook().findOrder(10), nullptr);
+    ASSERT_NE(restarted.getOrderBook().findOrder(11), nullptr);
+    EXPECT_EQ(restarted.getOrderBook().findOrder(11)->stopPrice, Price{ 95.0 });
+
+    OrderBook book;
+    book.loadSnapshot(snapshot);
+    EXPECT_EQ(book.lastTradePrice(), Price{ 100.0 });
+    ASSERT_NE(book.findOrder(10), nullptr);
+    EXPECT_EQ(book.findOrder(10)->stopPrice, Price{ 101.0 });
+}
+
+// --- 8. После сбоя оборванная запись отрезается, новые записи журнала читаются ---
+TEST(RecoveryTest, AppendAfterTornRecordStaysAligned) {
+    std::string journal = tempPath("torn_append_journal.bin");
+    {
+        MatchingEngine engine(LogMode::Off);
+        engine.openJournal(journal);
+        engine.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+        engine.processOrder({2, Side::Buy, OrderType::Limit, 98.0, 10});
+    }
+    std::filesystem::resize_file(journal, std::filesystem::file_size(journal) - sizeof(JournalRecord) + 20);
+
+    {
+        MatchingEngine engine(LogMode::Off);
+        engine.openJournal(journal);
+        EXPECT_EQ(engine.recover(tempPath("no_snapshot.bin"), journal), 1);
+        engine.processOrder({3, Side::Sell, OrderType::Limit, 101.0, 5});
+    }
+
+    std::vector<uint64_t> sequences;
+    std::vector<uint64_t> ids;
+    Journal::replay(journal, 1, [&](const JournalRecord& record) {
+        sequences.push_back(record.sequence);
+        ids.push_back(record.id);
+    });
+    EXPECT_EQ(sequences, (std::vector<uint64_t>{ 1, 2 }));
+    EXPECT_EQ(ids, (std::vector<uint64_t>{ 1, 3 }));
+
+    MatchingEngine restarted(LogMode::Off);
+    EXPECT_EQ(restarted.recover(tempPath("no_snapshot.bin"), journal), 2);
+    EXPECT_NE(restarted.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(restarted.getOrderBook().findOrder(2), nullptr);
+    EXPECT_NE(restarted.getOrderBook().findOrder(3), nullptr);
+}
+
+// --- 9. Файл чужого формата не читается ни журналом, ни OrderFile ---
+TEST(RecoveryTest, ForeignFileFormatIsRefused) {
+    std::string journal = tempPath("foreign_journal.bin");
+    {
+        MatchingEngine engine(LogMode::Off);
+        engine.openJournal(journal);
+        engine.processOrder({1, Side::Buy, OrderType::Limit, 99.0, 10});
+    }
+    EXPECT_EQ(OrderFile(journal).records().size(), 1u);
+
+    // Другая версия формата в заголовке
+    JournalFileHeader header;
+    header.version = JournalFileHeader::kVersion + 1;
+    {
+        std::fstream file(journal, std::ios::binary | std::ios::in | std::ios::out);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    auto ignore = [](const JournalRecord&) {};
+    EXPECT_THROW(Journal::replay(journal, 1, ignore), std::runtime_error);
+    EXPECT_THROW(Journal{ journal }, std::runtime_error);
+    EXPECT_THROW(OrderFile{ journal }, std::runtime_error);
+
+    MatchingEngine engine(LogMode::Off);
+    EXPECT_THROW(engine.recover(tempPath("no_snapshot.bin"), journal), std::runtime_error);
+}
+
+// --- 10. Старый файл без заголовка (48-байтные записи без стоп-цены) отклоняется ---
+TEST(RecoveryTest, LegacyHeaderlessFileIsRefused) {
+    std::string path = tempPath("legacy_orders.bin");
+    {
+        // Прежний формат: sequence, kind, side, type, reserved, instrument, id, targetId, price_raw, quantity
+        std::ofstream file(path, std::ios::binary);
+        for (uint64_t sequence = 1; sequence <= 3; ++sequence) {
+            unsigned char record[48]{};
+            std::memcpy(record, &sequence, sizeof(sequence));
+            file.write(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+    }
+    auto ignore = [](const JournalRecord&) {};
+    EXPECT_THROW(Journal::replay(path, 1, ignore), std::runtime_error);
+    EXPECT_THROW(OrderFile{ path }, std::runtime_error);
+    EXPECT_THROW(Journal{ path }, std::runtime_error);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "../include/matching_engine.hpp"
+#include "../include/pre_trade_risk.hpp"
+#include <limits>
+
+// Заявка конкретного счёта
+static Order accountOrder(uint64_t id, Side side, OrderType type, double price, uint64_t qty, AccountId account) {
+    return { id, side, type, price, qty, 0, account };
+}
+
+// --- 1. Размер заявки и неизвестный счёт: отказ до движка ---
+TEST(PreTradeRiskTest, OrderSizeAndUnknownAccount) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(2);
+    risk.setLimits(0, { .maxOrderQty = 100 });
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(1, Side::Buy, OrderType::Limit, 100.0, 101, 0)), RiskReject::OrderSize);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::Rejected);
+    EXPECT_EQ(engine.getOrderBook().findOrder(1), nullptr);
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(2, Side::Buy, OrderType::Limit, 100.0, 100, 0)), RiskReject::None);
+    EXPECT_NE(engine.getOrderBook().findOrder(2), nullptr);
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(3, Side::Buy, OrderType::Limit, 100.0, 1, 7)), RiskReject::UnknownAccount);
+    EXPECT_EQ(risk.rejected(RiskReject::OrderSize), 1u);
+    EXPECT_EQ(risk.rejected(RiskReject::UnknownAccount), 1u);
+    // Отклонённые заявки не журналируются
+    EXPECT_EQ(engine.inputSequence(), 1u);
+}
+
+// --- 2. Ценовой коридор относительно лучшей встречной цены ---
+TEST(PreTradeRiskTest, PriceCollarAgainstOppositeBest) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(2);
+    risk.setLimits(1, { .priceCollar = 1.0 });
+
+    // Пустая встречная сторона: ориентира нет, коридор не проверяется
+    EXPECT_EQ(risk.submit(engine, accountOrder(1, Side::Sell, OrderType::Limit, 100.0, 5, 0)), RiskReject::None);
+    EXPECT_EQ(risk.submit(engine, accountOrder(2, Side::Buy, OrderType::Limit, 101.5, 1, 1)), RiskReject::PriceCollar);
+    EXPECT_EQ(risk.submit(engine, accountOrder(3, Side::Buy, OrderType::Limit, 101.0, 1, 1)), RiskReject::None);
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(4, Side::Buy, OrderType::Limit, 99.0, 5, 0)), RiskReject::None);
+    EXPECT_EQ(risk.submit(engine, accountOrder(5, Side::Sell, OrderType::Limit, 97.5, 1, 1)), RiskReject::PriceCollar);
+    EXPECT_EQ(risk.submit(engine, accountOrder(6, Side::Sell, OrderType::Limit, 98.0, 1, 1)), RiskReject::None);
+}
+
+// --- 3. Позиция: исполнения агрессора и пассивной стороны, открытый объём ---
+TEST(PreTradeRiskTest, PositionFollowsFills) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(2);
+    risk.setLimits(0, { .maxPosition = 10 });
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(1, Side::Sell, OrderType::Limit, 100.0, 4, 1)), RiskReject::None);
+    EXPECT_EQ(risk.exposure(1).openSell, 4u);
+
+    // Покупка 6: 4 исполняются, 2 встают в книгу
+    EXPECT_EQ(risk.submit(engine, accountOrder(2, Side::Buy, OrderType::Limit, 100.0, 6, 0)), RiskReject::None);
+    EXPECT_EQ(risk.exposure(0).position, 4);
+    EXPECT_EQ(risk.exposure(0).openBuy, 2u);
+    EXPECT_EQ(risk.exposure(1).position, -4);
+    EXPECT_EQ(risk.exposure(1).openSell, 0u);
+
+    // 4 + 2 + 5 > 10
+    EXPECT_EQ(risk.submit(engine, accountOrder(3, Side::Buy, OrderType::Limit, 99.0, 5, 0)), RiskReject::Position);
+    EXPECT_EQ(risk.submit(engine, accountOrder(4, Side::Buy, OrderType::Limit, 99.0, 4, 0)), RiskReject::None);
+    // Продажа сокращает длинную позицию: -4 + 0 + 14 = 10
+    EXPECT_EQ(risk.submit(engine, accountOrder(5, Side::Sell, OrderType::Limit, 105.0, 14, 0)), RiskReject::None);
+
+    // Отмена освобождает открытый объём
+    risk.cancel(engine, 2);
+    EXPECT_EQ(risk.exposure(0).openBuy, 4u);
+    risk.reduce(engine, 4, 1);
+    EXPECT_EQ(risk.exposure(0).openBuy, 1u);
+}
+
+// --- 4. Лимит открытого оборота, рыночные заявки по встречной цене ---
+TEST(PreTradeRiskTest, NotionalLimit) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(1);
+    risk.setLimits(0, { .maxNotional = 1000.0 });
+
+    EXPECT_EQ(risk.submit(engine, accountOrder(1, Side::Buy, OrderType::Limit, 100.0, 8, 0)), RiskReject::None);
+    EXPECT_EQ(risk.exposure(0).openNotional, Price{ 800.0 }.raw());
+    EXPECT_EQ(risk.submit(engine, accountOrder(2, Side::Buy, OrderType::Limit, 100.0, 3, 0)), RiskReject::Notional);
+    EXPECT_EQ(risk.submit(engine, accountOrder(3, Side::Buy, OrderType::Limit, 100.0, 2, 0)), RiskReject::None);
+
+    // Продажа по рынку оценивается по лучшему биду: 100 * 3 сверх 1000
+    EXPECT_EQ(risk.submit(engine, accountOrder(4, Side::Sell, OrderType::Market, 0.0, 3, 0)), RiskReject::Notional);
+    risk.cancel(engine, 1);
+    EXPECT_EQ(risk.exposure(0).openNotional, Price{ 200.0 }.raw());
+    EXPECT_EQ(risk.submit(engine, accountOrder(5, Side::Sell, OrderType::Market, 0.0, 2, 0)), RiskReject::None);
+    EXPECT_EQ(risk.exposure(0).openNotional, 0);
+    EXPECT_EQ(risk.exposure(0).position, 0);
+}
+
+// --- 5. Ограничение частоты сообщений (GCRA) ---
+TEST(PreTradeRiskTest, ThrottleAllowsBurstThenRate) {
+    PreTradeRisk risk(1);
+    risk.setLimits(0, { .maxMessagesPerSecond = 1000, .burst = 3 });
+    Order order{ 1, Side::Buy, OrderType::Limit, 100.0, 1 };
+
+    uint64_t now{ 1'000'000'000 };
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(risk.check(order, std::nullopt, std::nullopt, now), RiskReject::None);
+    EXPECT_EQ(risk.check(order, std::nullopt, std::nullopt, now), RiskReject::Throttled);
+
+    // Через 1 мс (в тиках) освобождается ровно одно место
+    auto millisecond{ static_cast<uint64_t>(1e6 / TscClock::nanosPerTick()) + 1 };
+    EXPECT_EQ(risk.check(order, std::nullopt, std::nullopt, now + millisecond), RiskReject::None);
+    EXPECT_EQ(risk.check(order, std::nullopt, std::nullopt, now + millisecond), RiskReject::Throttled);
+    EXPECT_EQ(risk.rejected(RiskReject::Throttled), 2u);
+}
+
+// --- 6. Замена проверяется как новая заявка ---
+TEST(PreTradeRiskTest, ReplaceIsChecked) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(1);
+    risk.setLimits(0, { .maxOrderQty = 10 });
+
+    risk.submit(engine, accountOrder(1, Side::Buy, OrderType::Limit, 100.0, 5, 0));
+    EXPECT_EQ(risk.replace(engine, 1, accountOrder(2, Side::Buy, OrderType::Limit, 100.0, 11, 0)), RiskReject::OrderSize);
+    EXPECT_NE(engine.getOrderBook().findOrder(1), nullptr);
+
+    EXPECT_EQ(risk.replace(engine, 1, accountOrder(2, Side::Buy, OrderType::Limit, 101.0, 7, 0)), RiskReject::None);
+    EXPECT_EQ(engine.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(risk.exposure(0).openBuy, 7u);
+    EXPECT_EQ(risk.exposure(0).openNotional, Price{ 707.0 }.raw());
+}
+
+// --- 8. Замена, отклонённая движком, не снимает экспозицию старой заявки ---
+TEST(PreTradeRiskTest, EngineRejectedReplaceKeepsExposure) {
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk risk(1);
+    risk.setLimits(0, { .maxPosition = 20, .maxNotional = 2000.0 });
+
+    risk.submit(engine, accountOrder(1, Side::Buy, OrderType::Limit, 100.0, 10, 0));
+    // Цена вне сетки и нулевой объём: старая заявка остаётся в книге
+    EXPECT_EQ(risk.replace(engine, 1, accountOrder(2, Side::Buy, OrderType::Limit, 99.995, 10, 0)), RiskReject::None);
+    EXPECT_EQ(engine.getReports().back().status, ExecStatus::ReplaceRejected);
+    risk.replace(engine, 1, accountOrder(3, Side::Buy, OrderType::Limit, 100.0, 0, 0));
+    ASSERT_NE(engine.getOrderBook().findOrder(1), nullptr);
+    EXPECT_EQ(risk.exposure(0).openBuy, 10u);
+    EXPECT_EQ(risk.exposure(0).openNotional, Price{ 1000.0 }.raw());
+
+    // Старый объём по-прежнему учитывается: 10 + 11 > 20
+    EXPECT_EQ(risk.submit(engine, accountOrder(4, Side::Buy, OrderType::Limit, 99.0, 11, 0)), RiskReject::Position);
+}
+
+// --- 7. Переполнение оборота: отказ вместо заворота через знак, открытый оборот насыщается ---
+TEST(PreTradeRiskTest, NotionalOverflowIsRejected) {
+    PreTradeRisk risk(1);
+    risk.setLimits(0, { .maxNotional = 1e6 });
+
+    // 1e10 (raw) * 1e9 не помещается в int64
+    Order huge{ 1, Side::Buy, OrderType::Limit, 10000.0, 1'000'000'000 };
+    EXPECT_EQ(risk.check(huge, std::nullopt, std::nullopt), RiskReject::Notional);
+    Order sell{ 2, Side::Sell, OrderType::Limit, 10000.0, 1'000'000'000'000 };
+    EXPECT_EQ(risk.check(sell, std::nullopt, std::nullopt), RiskReject::Notional);
+    Order beyondInt64{ 3, Side::Buy, OrderType::Limit, 1.0, (uint64_t{ 1 } << 63) + 1 };
+    EXPECT_EQ(risk.check(beyondInt64, std::nullopt, std::nullopt), RiskReject::OrderSize);
+
+    // Без лимита оборота заявки встают (каждая по отдельности помещается в int64),
+    // открытый оборот упирается в предел; отмена вычитает оборот заявки из предела
+    MatchingEngine engine(LogMode::Off);
+    PreTradeRisk open(1);
+    open.setLimits(0, {});
+    EXPECT_EQ(open.submit(engine, accountOrder(4, Side::Buy, OrderType::Limit, 10000.0, 500'000'000, 0)),
+              RiskReject::None);
+    EXPECT_EQ(open.submit(engine, accountOrder(5, Side::Buy, OrderType::Limit, 10000.0, 500'000'000, 0)),
+              RiskReject::None);
+    EXPECT_EQ(open.exposure(0).openNotional, std::numeric_limits<int64_t>::max());
+    open.cancel(engine, 4);
+    EXPECT_EQ(open.exposure(0).openNotional, std::numeric_limits<int64_t>::max() - Price{ 10000.0 }.raw() * 500'000'000);
+    open.cancel(engine, 5);
+    EXPECT_EQ(open.exposure(0).openBuy, 0u);
+}
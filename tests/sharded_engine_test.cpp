@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "../include/sharded_engine.hpp"
+
+// --- 1. Символы получают последовательные id и раскладываются по шардам ---
+TEST(ShardedEngineTest, InstrumentsAreDealtAcrossShards) {
+    ShardedEngine engine(2, false);
+    InstrumentId aapl{ engine.addInstrument("AAPL") };
+    InstrumentId msft{ engine.addInstrument("MSFT") };
+    InstrumentId goog{ engine.addInstrument("GOOG") };
+
+    EXPECT_EQ(engine.instrumentId("MSFT"), msft);
+    EXPECT_EQ(engine.shardOf(aapl), 0);
+    EXPECT_EQ(engine.shardOf(msft), 1);
+    EXPECT_EQ(engine.shardOf(goog), 0);
+    EXPECT_THROW(engine.addInstrument("AAPL"), std::invalid_argument);
+    EXPECT_THROW(engine.instrumentId("TSLA"), std::out_of_range);
+}
+
+// --- 2. Книги разных инструментов независимы ---
+TEST(ShardedEngineTest, OrdersMatchOnlyWithinTheirInstrument) {
+    ShardedEngine engine(2, false);
+    InstrumentId aapl{ engine.addInstrument("AAPL") };
+    InstrumentId msft{ engine.addInstrument("MSFT") };
+    engine.start();
+
+    engine.submit({1, Side::Sell, OrderType::Limit, 100.0, 10, aapl});
+    engine.submit({2, Side::Buy, OrderType::Limit, 100.0, 10, msft}); // другой инструмент — нет сделки
+    engine.submit({3, Side::Buy, OrderType::Limit, 100.0, 4, aapl});
+    engine.submit({4, Side::Sell, OrderType::Market, 0.0, 10, msft});
+    engine.stop();
+
+    EXPECT_EQ(engine.processedOrders(), 4);
+    EXPECT_EQ(engine.executedTrades(), 2);
+
+    const auto& aaplTrades = engine.getOrderBook(aapl).getTrades();
+    ASSERT_EQ(aaplTrades.size(), 1);
+    EXPECT_EQ(aaplTrades[0].buy_id, 3);
+    EXPECT_EQ(aaplTrades[0].sell_id, 1);
+    EXPECT_EQ(aaplTrades[0].instrument, aapl);
+
+    const auto& msftTrades = engine.getOrderBook(msft).getTrades();
+    ASSERT_EQ(msftTrades.size(), 1);
+    EXPECT_EQ(msftTrades[0].buy_id, 2);
+    EXPECT_EQ(msftTrades[0].instrument, msft);
+}
+
+// --- 3. stop() дожидается обработки всей очереди ---
+TEST(ShardedEngineTest, StopDrainsQueues) {
+    ShardedEngine engine(3, false);
+    for (int i = 0; i < 6; ++i)
+        engine.addInstrument("SYM" + std::to_string(i));
+    engine.start();
+
+    for (uint64_t id = 0; id < 20'000; ++id)
+        engine.submit({id, id % 2 == 0 ? Side::Buy : Side::Sell, OrderType::Limit, 100.0, 1,
+                       static_cast<InstrumentId>((id / 2) % 6)});
+    engine.stop();
+
+    EXPECT_EQ(engine.processedOrders(), 20'000);
+    EXPECT_EQ(engine.executedTrades(), 10'000);
+}
+
+// --- 4. Заявки вне сетки и диапазона книги отклоняются шардом и считаются ---
+TEST(ShardedEngineTest, OrdersOffTheGridAreRejected) {
+    ShardedEngine engine(2, false);
+    OrderBookConfig config{ .minPrice = 90.0, .maxPrice = 110.0, .tickSize = 0.01, .orderCapacity = 64 };
+    InstrumentId aapl{ engine.addInstrument("AAPL", config) };
+    InstrumentId msft{ engine.addInstrument("MSFT", config) };
+    engine.start();
+
+    engine.submit({1, Side::Buy, OrderType::Limit, 100.0, 10, aapl});
+    engine.submit({2, Side::Buy, OrderType::Limit, 100.005, 10, aapl}); // вне сетки
+    engine.submit({3, Side::Buy, OrderType::Limit, 500.0, 10, aapl});   // выше maxPrice
+    engine.submit({4, Side::Sell, OrderType::Limit, 101.0, 0, msft});   // нулевой объём
+    engine.submit({5, Side::Sell, OrderType::Limit, 101.0, 5, msft});
+    engine.stop();
+
+    EXPECT_EQ(engine.processedOrders(), 2);
+    EXPECT_EQ(engine.rejectedOrders(), 3);
+    EXPECT_EQ(engine.rejectedOrders(engine.shardOf(aapl)), 2);
+    EXPECT_EQ(engine.rejectedOrders(engine.shardOf(msft)), 1);
+
+    const OrderBook& book = engine.getOrderBook(aapl);
+    EXPECT_EQ(book.bestBid(), Price{ 100.0 });
+    EXPECT_EQ(book.findOrder(2), nullptr);
+    EXPECT_EQ(book.findOrder(3), nullptr);
+    EXPECT_EQ(engine.getOrderBook(msft).findOrder(4), nullptr);
+    EXPECT_NE(engine.getOrderBook(msft).findOrder(5), nullptr);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../include/spscqueue.hpp"
+#include <thread>
+
+// --- 1. Используются все N слотов ---
+TEST(SPSCQueueTest, FullCapacityIsUsable) {
+    SPSCQueue<int, 8> queue;
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.push(8));
+    EXPECT_EQ(queue.size(), 8);
+
+    int value{ -1 };
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+// --- 2. claim/commit не переходит через конец буфера ---
+TEST(SPSCQueueTest, ClaimStopsAtWrapAndCommitPublishes) {
+    SPSCQueue<int, 8> queue;
+    for (int i = 0; i < 6; ++i)
+        queue.push(i);
+    std::vector<int> drained;
+    queue.popBatch(drained, 6);
+
+    // head = tail = 6: до конца буфера осталось 2 слота
+    std::span<int> slots{ queue.claimWrite(5) };
+    ASSERT_EQ(slots.size(), 2);
+    slots[0] = 100;
+    slots[1] = 101;
+    queue.commitWrite(2);
+    slots = queue.claimWrite(5);
+    ASSERT_EQ(slots.size(), 5);
+    for (int i = 0; i < 5; ++i)
+        slots[i] = 102 + i;
+    queue.commitWrite(5);
+    EXPECT_EQ(queue.size(), 7);
+
+    std::span<int> items{ queue.claimRead(16) };
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items[0], 100);
+    items[1] += 1000; // обработка на месте
+    queue.commitRead(1);
+
+    std::vector<int> rest;
+    EXPECT_EQ(queue.popBatch(rest, 16), 6);
+    EXPECT_EQ(rest, (std::vector<int>{ 1101, 102, 103, 104, 105, 106 }));
+}
+
+// --- 3. Порядок сохраняется между потоками ---
+TEST(SPSCQueueTest, ProducerConsumerPreservesOrder) {
+    constexpr uint64_t kItems{ 200'000 };
+    SPSCQueue<uint64_t, 256> queue;
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < kItems; ++i)
+            while (!queue.push(i))
+                std::this_thread::yield();
+    });
+
+    uint64_t expected{ 0 };
+    while (expected < kItems) {
+        std::span<uint64_t> items{ queue.claimRead(64) };
+        if (items.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (uint64_t item : items)
+            ASSERT_EQ(item, expected++);
+        queue.commitRead(items.size());
+    }
+    producer.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include "../include/wire_protocol.hpp"
+#include "../include/order_flow.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using Buffer = std::vector<std::byte>;
+
+static void append(Buffer& buffer, std::size_t size) {
+    buffer.resize(buffer.size() + size);
+}
+
+static Buffer encodeOrder(const Order& order) {
+    Buffer buffer(WireLayout::kNewOrderSize);
+    EXPECT_EQ(encodeNewOrder(buffer, order), WireLayout::kNewOrderSize);
+    return buffer;
+}
+
+// Кадр с изменённым байтом
+static Buffer patched(Buffer buffer, std::size_t offset, uint8_t value) {
+    buffer[offset] = std::byte{ value };
+    return buffer;
+}
+
+static WireError peek(const Buffer& buffer) {
+    WireFrame frame;
+    return peekFrame(buffer, frame);
+}
+
+// Стакан согласован: каждая заявка на сетке цен, агрегаты уровней равны сумме заявок
+template <typename Book>
+static void expectConsistent(const Book& book) {
+    for (Side side : { Side::Buy, Side::Sell }) {
+        std::map<int64_t, uint64_t> fromOrders;
+        book.forEachOrder(side, [&](const Order& order) {
+            EXPECT_TRUE(book.onGrid(order.price)) << order.price;
+            EXPECT_GT(order.quantity, 0u);
+            fromOrders[order.price.raw()] += order.quantity;
+        });
+        std::map<int64_t, uint64_t> fromLevels;
+        book.forEachLevel(side, SIZE_MAX, [&](Price price, uint64_t quantity, std::size_t) {
+            fromLevels[price.raw()] = quantity;
+        });
+        EXPECT_EQ(fromOrders, fromLevels);
+    }
+}
+
+// --- 1. NewOrder: кодирование и разбор на месте без потерь, включая стоп-цену и счёт ---
+TEST(WireProtocolTest, NewOrderRoundTrip) {
+    Order order{ 42, Side::Sell, OrderType::StopLimit, 99.5, 300, 7, 11 };
+    order.stopPrice = Price{ 100.25 };
+    Buffer buffer{ encodeOrder(order) };
+
+    // Little-endian на проводе независимо от платформы
+    EXPECT_EQ(buffer[0], std::byte{ WireLayout::kNewOrderSize });
+    EXPECT_EQ(buffer[2], std::byte{ 1 });
+    EXPECT_EQ(buffer[8], std::byte{ 42 });
+
+    WireFrame frame;
+    ASSERT_EQ(peekFrame(buffer, frame), WireError::None);
+    EXPECT_EQ(frame.type(), WireType::NewOrder);
+    EXPECT_EQ(frame.size(), WireLayout::kNewOrderSize);
+
+    Order decoded{ frame.newOrder().toOrder() };
+    EXPECT_EQ(decoded.id, 42u);
+    EXPECT_EQ(decoded.side, Side::Sell);
+    EXPECT_EQ(decoded.type, OrderType::StopLimit);
+    EXPECT_EQ(decoded.price, Price{ 99.5 });
+    EXPECT_EQ(decoded.stopPrice, Price{ 100.25 });
+    EXPECT_EQ(decoded.quantity, 300u);
+    EXPECT_EQ(decoded.instrument, 7u);
+    EXPECT_EQ(decoded.account, 11u);
+    EXPECT_EQ(frame.account(), 11u);
+
+    JournalRecord record{ frame.record() };
+    EXPECT_EQ(record.kind, JournalKind::New);
+    EXPECT_EQ(record.stop_raw, order.stopPrice.raw());
+
+    Buffer small(WireLayout::kNewOrderSize - 1);
+    EXPECT_EQ(encodeNewOrder(small, order), 0u);
+}
+
+// --- 2. Cancel, Replace и ExecutionReport ---
+TEST(WireProtocolTest, CancelReplaceAndReportRoundTrip) {
+    Buffer buffer(WireLayout::kMaxFrameSize);
+    WireFrame frame;
+
+    ASSERT_EQ(encodeCancel(buffer, 17), WireLayout::kCancelSize);
+    ASSERT_EQ(peekFrame(buffer, frame), WireError::None);
+    EXPECT_EQ(frame.type(), WireType::Cancel);
+    EXPECT_EQ(frame.targetId(), 17u);
+    EXPECT_EQ(frame.record().kind, JournalKind::Cancel);
+    EXPECT_EQ(frame.record().targetId, 17u);
+
+    ASSERT_EQ(encodeReplace(buffer, 17, { 18, Side::Buy, OrderType::Limit, 101.0, 5, 0, 3 }), WireLayout::kReplaceSize);
+    ASSERT_EQ(peekFrame(buffer, frame), WireError::None);
+    EXPECT_EQ(frame.type(), WireType::Replace);
+    EXPECT_EQ(frame.targetId(), 17u);
+    EXPECT_EQ(frame.replacement().id(), 18u);
+    EXPECT_EQ(frame.replacement().price(), Price{ 101.0 });
+    EXPECT_EQ(frame.account(), 3u);
+    EXPECT_EQ(frame.record().kind, JournalKind::Replace);
+    EXPECT_EQ(frame.record().targetId, 17u);
+
+    ExecutionReport report{ 9, ExecStatus::PartiallyFilled, Price{ 100.0 }, 50 };
+    report.filledQty = 20;
+    report.leavesQty = 30;
+    report.avgFillPrice = Price{ 99.75 };
+    ASSERT_EQ(encodeExecutionReport(buffer, report), WireLayout::kExecutionReportSize);
+    ASSERT_EQ(peekFrame(buffer, frame), WireError::None);
+    ExecutionReport decoded{ frame.executionReport() };
+    EXPECT_EQ(decoded.id, 9u);
+    EXPECT_EQ(decoded.status, ExecStatus::PartiallyFilled);
+    EXPECT_EQ(decoded.price, Price{ 100.0 });
+    EXPECT_EQ(decoded.quantity, 50u);
+    EXPECT_EQ(decoded.filledQty, 20u);
+    EXPECT_EQ(decoded.leavesQty, 30u);
+    EXPECT_EQ(decoded.avgFillPrice, Price{ 99.75 });
+}
+
+// --- 3. Каждый вид битого кадра распознаётся ---
+TEST(WireProtocolTest, MalformedFramesAreRejected) {
+    Buffer order{ encodeOrder({ 1, Side::Buy, OrderType::Limit, 100.0, 10 }) };
+    ASSERT_EQ(peek(order), WireError::None);
+
+    EXPECT_EQ(peek(Buffer(order.begin(), order.begin() + 7)), WireError::Incomplete);
+    EXPECT_EQ(peek(Buffer(order.begin(), order.end() - 1)), WireError::Incomplete);
+    EXPECT_EQ(peek(patched(order, 0, WireLayout::kCancelSize)), WireError::BadLength);
+    EXPECT_EQ(peek(patched(order, 2, 0)), WireError::UnknownType);
+    EXPECT_EQ(peek(patched(order, 2, 5)), WireError::UnknownType);
+    EXPECT_EQ(peek(patched(order, 4, 2)), WireError::BadVersion);
+    EXPECT_EQ(peek(patched(order, 6, 1)), WireError::BadField);
+    EXPECT_EQ(peek(patched(order, 48, 2)), WireError::BadField); // side
+    EXPECT_EQ(peek(patched(order, 49, 4)), WireError::BadField); // order type
+    EXPECT_EQ(peek(patched(order, 55, 1)), WireError::BadField); // padding
+
+    Buffer report(WireLayout::kExecutionReportSize);
+    encodeExecutionReport(report, { 1, ExecStatus::Filled, Price{ 1.0 }, 1 });
+    EXPECT_EQ(peek(patched(report, 56, 10)), WireError::BadField);
+    EXPECT_EQ(peek(patched(report, 63, 1)), WireError::BadField);
+
+    // Длина проверяется до того, как кадр дочитан: мусорный поток не ждёт 64 КБ
+    Buffer huge{ patched(order, 1, 0xFF) };
+    EXPECT_EQ(peek(Buffer(huge.begin(), huge.begin() + 8)), WireError::BadLength);
+}
+
+// --- 4. Поток кадров: хвост без конца кадра дочитывается со следующей порцией ---
+TEST(WireProtocolTest, StreamDecodingResumesAfterPartialFrame) {
+    Buffer stream;
+    for (uint64_t id = 1; id <= 10; ++id) {
+        std::size_t offset{ stream.size() };
+        append(stream, WireLayout::kMaxFrameSize);
+        std::size_t written{ id % 3 == 0 ? encodeCancel(std::span{ stream }.subspan(offset), id - 1)
+                                         : encodeNewOrder(std::span{ stream }.subspan(offset),
+                                                          { id, Side::Buy, OrderType::Limit, 100.0, id }) };
+        stream.resize(offset + written);
+    }
+
+    std::vector<uint64_t> seen;
+    auto handler = [&seen](const WireFrame& frame) {
+        seen.push_back(frame.type() == WireType::Cancel ? frame.targetId() : frame.newOrder().id());
+    };
+
+    std::size_t split{ stream.size() / 2 + 3 };
+    std::size_t consumed{ 0 };
+    EXPECT_EQ(decodeFrames(std::span{ stream }.first(split), consumed, handler), WireError::Incomplete);
+    EXPECT_LT(consumed, split);
+    std::size_t first{ seen.size() };
+
+    std::size_t rest{ 0 };
+    EXPECT_EQ(decodeFrames(std::span{ stream }.subspan(consumed), rest, handler), WireError::None);
+    EXPECT_EQ(consumed + rest, stream.size());
+    EXPECT_GT(first, 0u);
+    EXPECT_EQ(seen, (std::vector<uint64_t>{ 1, 2, 2, 4, 5, 5, 7, 8, 8, 10 }));
+}
+
+// --- 5. Фаззинг: случайные и испорченные кадры не читают за буфер, принятый кадр канонический,
+//        стакан, в который идут принятые кадры, остаётся согласованным ---
+TEST(WireProtocolTest, FuzzMalformedFrames) {
+    std::mt19937_64 random(25);
+    OrderFlowConfig config;
+    config.seed = 25;
+    OrderFlowGenerator generator(config);
+    MatchingEngine engine(LogMode::Off, OrderBookConfig{ .orderCapacity = 1 << 18 }, 16);
+
+    uint64_t accepted{ 0 };
+    uint64_t refused{ 0 };
+    uint64_t oversized{ 0 };
+    for (int iteration = 0; iteration < 200'000; ++iteration) {
+        // Валидный кадр как основа, затем порча: случайные байты, обрезка, мусор целиком
+        Buffer frame(WireLayout::kMaxFrameSize);
+        Order order{ generator.next().toOrder() };
+        order.account = static_cast<AccountId>(random());
+        switch (random() % 4) {
+            case 0:  frame.resize(encodeNewOrder(frame, order)); break;
+            case 1:  frame.resize(encodeCancel(frame, order.id)); break;
+            case 2:  frame.resize(encodeReplace(frame, random(), order)); break;
+            default: frame.resize(encodeExecutionReport(frame, { order.id, ExecStatus::Accepted, order.price,
+                                                                 order.quantity })); break;
+        }
+        switch (random() % 3) {
+            case 0:
+                for (uint64_t flips = random() % 4 + 1; flips > 0; --flips)
+                    frame[random() % frame.size()] = std::byte{ static_cast<uint8_t>(random()) };
+                break;
+            case 1:
+                frame.resize(random() % frame.size());
+                break;
+            default:
+                frame.resize(random() % (WireLayout::kMaxFrameSize + 8));
+                for (std::byte& b : frame)
+                    b = std::byte{ static_cast<uint8_t>(random()) };
+                break;
+        }
+
+        // Точный размер: выход за буфер поймает санитайзер
+        Buffer exact(frame);
+        std::size_t consumed{ 0 };
+        WireError error{ decodeFrames(exact, consumed, [&](const WireFrame& decoded) {
+            ++accepted;
+            ASSERT_LE(decoded.size(), exact.size());
+            // Принятый кадр кодируется обратно байт в байт
+            Buffer again(WireLayout::kMaxFrameSize);
+            switch (decoded.type()) {
+                case WireType::NewOrder: again.resize(encodeNewOrder(again, decoded.newOrder().toOrder())); break;
+                case WireType::Cancel:   again.resize(encodeCancel(again, decoded.targetId())); break;
+                case WireType::Replace:
+                    again.resize(encodeReplace(again, decoded.targetId(), decoded.replacement().toOrder()));
+                    break;
+                case WireType::ExecutionReport:
+                    again.resize(encodeExecutionReport(again, decoded.executionReport()));
+                    break;
+            }
+            ASSERT_TRUE(std::equal(again.begin(), again.end(), exact.begin(), exact.begin() + decoded.size()));
+
+            // Цена и объём из сети проверяются на входе в движок
+            if (decoded.type() == WireType::ExecutionReport)
+                return;
+            engine.apply(decoded.record());
+            if (decoded.type() == WireType::NewOrder && engine.getReports().back().status == ExecStatus::Rejected)
+                ++refused;
+            // Объём, при котором оборот по максимальной цене не помещается в int64, не доходит до книги
+            int64_t notional;
+            Order order{ decoded.record().toOrder() };
+            if (decoded.type() != WireType::Cancel
+                && __builtin_mul_overflow(Price{ 10000.0 }.raw(), order.quantity, &notional)) {
+                ++oversized;
+                ASSERT_EQ(engine.getReports().back().status,
+                          decoded.type() == WireType::NewOrder ? ExecStatus::Rejected : ExecStatus::ReplaceRejected);
+            }
+        }) };
+        ASSERT_LE(consumed, exact.size());
+        if (error == WireError::None)
+            ASSERT_EQ(consumed, exact.size());
+        else
+            ASSERT_NE(toString(error), std::string("unknown"));
+        if (iteration % 20'000 == 0)
+            expectConsistent(engine.getOrderBook());
+    }
+    // Порча попадает и в значимые поля, часть кадров остаётся корректной
+    EXPECT_GT(accepted, 10'000u);
+    EXPECT_LT(accepted, 200'000u);
+    EXPECT_GT(refused, 0u);
+    EXPECT_GT(oversized, 0u);
+    expectConsistent(engine.getOrderBook());
+}
+
+// --- 6. Кадры из сети ведут движок так же, как заявки, собранные в C++ ---
+TEST(WireProtocolTest, DecodedFramesDriveTheEngine) {
+    OrderFlowConfig config;
+    config.seed = 26;
+    OrderFlowGenerator generator(config);
+    std::vector<JournalRecord> records(5000);
+    generator.generate(records.data(), records.size());
+
+    Buffer stream;
+    MatchingEngine direct(LogMode::Off);
+    for (const auto& record : records) {
+        direct.apply(record);
+        std::size_t offset{ stream.size() };
+        append(stream, WireLayout::kMaxFrameSize);
+        std::span<std::byte> out{ std::span{ stream }.subspan(offset) };
+        switch (record.kind) {
+            case JournalKind::New:     stream.resize(offset + encodeNewOrder(out, record.toOrder())); break;
+            case JournalKind::Cancel:  stream.resize(offset + encodeCancel(out, record.targetId)); break;
+            case JournalKind::Replace:
+                stream.resize(offset + encodeReplace(out, record.targetId, record.toOrder()));
+                break;
+            default: FAIL() << "unexpected record kind";
+        }
+    }
+
+    MatchingEngine engine(LogMode::Off);
+    Buffer reports(WireLayout::kExecutionReportSize);
+    std::size_t consumed{ 0 };
+    ASSERT_EQ(decodeFrames(stream, consumed, [&](const WireFrame& frame) {
+        engine.apply(frame.record());
+        // Отчёт движка уходит обратно в том же формате
+        ASSERT_EQ(encodeExecutionReport(reports, engine.getReports().back()), WireLayout::kExecutionReportSize);
+        ASSERT_EQ(peek(reports), WireError::None);
+    }), WireError::None);
+
+    EXPECT_EQ(consumed, stream.size());
+    EXPECT_EQ(engine.getOrderBook().getTrades().nextSequence(), direct.getOrderBook().getTrades().nextSequence());
+    EXPECT_EQ(engine.getOrderBook().bestBid(), direct.getOrderBook().bestBid());
+    EXPECT_EQ(engine.getOrderBook().bestAsk(), direct.getOrderBook().bestAsk());
+    EXPECT_EQ(engine.inputSequence(), direct.inputSequence());
+}